@@ -23,6 +23,18 @@ namespace hypha
         std::optional<Period> getNextClaimablePeriod ();
         bool isClaimed (Period* period);
 
+        /**
+         * @brief Marks the period returned by getNextClaimablePeriod as claimed
+         * and advances the claim cursor of the assignment
+         */
+        void setClaimed (Period& period);
+
+        /**
+         * @brief Removes the claim cursor of the assignment, used when the assignment
+         * is withdrawn, suspended or removed. Remaining periods are found by scanning the calendar
+         */
+        static void eraseClaimCursor (dao& dao, uint64_t assignmentID);
+
         TimeShare getInitialTimeShare();
         TimeShare getCurrentTimeShare();
         TimeShare getLastTimeShare();
@@ -32,5 +44,10 @@ namespace hypha
         inline uint64_t getDaoID() { return m_daoID; }
     private: 
         eosio::asset getAsset (std::string_view key);
+
+        std::optional<Period> scanNextClaimablePeriod ();
+
+        //Index (relative to the start period) of the period found by getNextClaimablePeriod
+        int64_t m_nextClaimIdx = -1;
     };
 } // namespace hypha
\ No newline at end of file
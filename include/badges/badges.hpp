@@ -10,6 +10,7 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
 #include "common.hpp"
 
 namespace hypha
@@ -41,6 +42,10 @@ void onBadgeArchived(dao& dao, RecurringActivity& badgeAssign);
 
 Document getBadgeOf(dao& dao, uint64_t badgeAssignID);
 
+bool hasAdminBadge(dao& dao, uint64_t daoID, uint64_t memberID);
+
+bool hasEnrollerBadge(dao& dao, uint64_t daoID, uint64_t memberID);
+
 bool hasNorthStarBadge(dao& dao, uint64_t daoID, uint64_t memberID);
 
 bool hasVoterBadge(dao& dao, uint64_t daoID, uint64_t memberID);
@@ -57,6 +62,23 @@ void checkHoldsBadge(dao& dao, Document& badge, uint64_t daoID, uint64_t memberI
 
 bool isSelfApproveBadge(SystemBadgeType systemType);
 
+/**
+ * @brief Sets or clears a system badge in the member badges table of the DAO
+ */
+void setSystemBadge(dao& dao, uint64_t daoID, uint64_t memberID, SystemBadgeType systemType, bool active);
+
+/**
+ * @brief Marks the member badges table of a new DAO as complete
+ */
+void initBadgeIndex(dao& dao, uint64_t daoID);
+
+/**
+ * @brief Rebuilds the system badges of up to maxMembers members of the DAO starting at from 
+ * based on their badge edges. Requires the DAO's membership index to be complete. 
+ * Returns the account to continue from or nothing once all the members were processed
+ */
+std::optional<eosio::name> indexBadges(dao& dao, uint64_t daoID, const eosio::name& from, size_t maxMembers);
+
 }
 
 } // namespace hypha
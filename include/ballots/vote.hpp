@@ -1,6 +1,9 @@
 #pragma once
 #include <typed_document.hpp>
 #include <string>
+#include <optional>
+#include <utility>
+#include <vector>
 #include <eosio/name.hpp>
 
 namespace hypha
@@ -23,7 +26,48 @@ namespace hypha
         const eosio::asset& getPower();
         const eosio::name& getVoter();
 
+        /**
+         * @brief Option and power of the vote replaced by this one,
+         * empty if this is the first vote of the voter on the proposal
+         */
+        const std::optional<std::pair<std::string, eosio::asset>>& getPreviousVote() const { return m_previousVote; }
+
+        /**
+         * @brief Marks the votes index of a newly published proposal as complete,
+         * so voters without a row in it are known to have not voted yet
+         */
+        static void initIndex(dao& dao, uint64_t proposalID);
+
+        /**
+         * @brief Adds existing votes of an open proposal to the votes index, the
+         * proposal is marked as complete once every vote is in the index
+         */
+        static void indexVotes(dao& dao, uint64_t proposalID, const std::vector<uint64_t>& voteIDs);
+
+        /**
+         * @brief Erases the votes index rows and voice power snapshots of a proposal once it can't be voted anymore,
+         * a page is erased right away and the rest by clearvotes actions in the deferred queue
+         */
+        static void eraseVotes(dao& dao, uint64_t proposalID);
+
+        /**
+         * @brief Erases up to maxRows votes index rows of a proposal, 
+         * returns true once there are no rows left
+         */
+        static bool eraseIndex(dao& dao, uint64_t proposalID, size_t maxRows);
+
+        /**
+         * @brief Erases up to maxRows voice power snapshots taken on the votes of a proposal,
+         * returns true once there are no snapshots left
+         */
+        static bool erasePowers(dao& dao, uint64_t proposalID, size_t maxRows);
+
     protected:
         virtual const std::string buildNodeLabel(ContentGroups &content);
+    private:
+        static std::optional<uint64_t> findVote(dao& dao, uint64_t proposalID, uint64_t voterID, const eosio::name& voter);
+        static void setIndexedVote(dao& dao, uint64_t proposalID, uint64_t voterID, uint64_t voteID);
+
+        std::optional<std::pair<std::string, eosio::asset>> m_previousVote;
     };
 }
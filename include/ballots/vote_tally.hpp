@@ -1,7 +1,10 @@
 #pragma once
 #include <typed_document.hpp>
 #include <string>
+#include <optional>
+#include <utility>
 #include <eosio/name.hpp>
+#include <eosio/asset.hpp>
 
 namespace hypha
 {
@@ -17,6 +20,40 @@ namespace hypha
             Settings* daoSettings
         );
 
+        /**
+         * @brief Updates the tally in place with the delta of a single vote,
+         * removing the power of the replaced vote (if any) and adding the new one
+         */
+        void updateVote(
+            const std::optional<std::pair<std::string, eosio::asset>>& previousVote,
+            const std::string& option,
+            const eosio::asset& power
+        );
+
+        /**
+         * @brief Creates the ballot row of a proposal with empty sums
+         * and the voice supply snapshot used to check the quorum on close
+         */
+        static void initBallot(dao& dao, uint64_t proposalID, const eosio::asset& supply);
+
+        /**
+         * @brief Applies the delta of a single vote to the ballot row of the proposal if it has one
+         */
+        static void updateBallot(
+            dao& dao,
+            uint64_t proposalID,
+            const std::optional<std::pair<std::string, eosio::asset>>& previousVote,
+            const std::string& option,
+            const eosio::asset& power
+        );
+
+        static void updateBallotVetoes(dao& dao, uint64_t proposalID, int32_t delta);
+
+        /**
+         * @brief Erases the ballot row of a proposal that was removed before being closed
+         */
+        static void eraseBallot(dao& dao, uint64_t proposalID);
+
     protected:
         virtual const std::string buildNodeLabel(ContentGroups &content);
     };
@@ -28,9 +28,14 @@ namespace hypha
 
         eosio::name getAuthor();
 
+        /**
+         * @brief Returns the id of the section the comment belongs to,
+         * following the parents of replies up to it
+         */
+        uint64_t getSectionId();
+
         void edit(const string& new_content);
         void markAsDeleted();
-        void remove();
 
     protected:
         virtual const std::string buildNodeLabel(ContentGroups &content);
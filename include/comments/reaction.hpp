@@ -44,8 +44,13 @@ namespace hypha
             static Reaction getReaction(dao& dao, Likeable& likeable, const eosio::name reaction);
             static Reaction getReactionByUser(dao& dao, Likeable& likeable, const eosio::name who);
 
+            //Erases the reactions and reaction counts rows of a likeable document that is being removed
+            static void eraseReactions(dao& dao, uint64_t likeableId);
+
         protected:
             virtual const std::string buildNodeLabel(ContentGroups &content);
             uint64_t getLikeableId();
+            eosio::name getType();
+            void updateCount(uint64_t likeableId, int64_t delta);
     };
 }
@@ -18,8 +18,20 @@ namespace hypha
                 Document& proposal
             );
 
+            /**
+             * @brief Marks the section as pending deletion and removes it with all
+             * its comments in bounded steps, continuing through the deferred actions
+             */
             const void remove();
 
+            /**
+             * @brief Removes the next batch of comments of a section pending deletion 
+             * and schedules the next one if there are comments left
+             */
+            static void removeNodes(dao& dao, uint64_t sectionID);
+
+            bool isPendingDeletion();
+
             const void move(Document& proposal);
         protected:
             virtual const std::string buildNodeLabel(ContentGroups &content);
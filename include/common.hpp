@@ -89,6 +89,11 @@ namespace hypha::common
     inline constexpr auto URLS_GROUP = "urls";
     inline constexpr auto URL = "url";
     inline constexpr auto CLAIM_ENABLED = "claim_enabled";
+    //Set to 0 to only record payments in the payments table, without receipt documents
+    inline constexpr auto PAYMENT_RECEIPTS = "payment_receipts";
+    //Set to 1 to snapshot voter power at the first vote and voice supply at publish,
+    //new DAOs start with it on while DAOs that don't have it read them live
+    inline constexpr auto VOICE_SNAPSHOT = "voice_snapshot";
     inline constexpr auto VOICE_MULTIPLIER = "voice_token_multiplier";
     inline constexpr auto REWARD_MULTIPLIER = "utility_token_multiplier";
     inline constexpr auto PEG_MULTIPLIER = "treasury_token_multiplier";
@@ -2,6 +2,9 @@
 
 #include <string_view>
 #include <memory>
+#include <map>
+#include <set>
+#include <optional>
 
 #include <eosio/eosio.hpp>
 #include <eosio/name.hpp>
@@ -10,6 +13,7 @@
 #include <eosio/multi_index.hpp>
 #include <eosio/singleton.hpp>
 #include <eosio/action.hpp>
+#include <eosio/binary_extension.hpp>
 
 #include <document_graph/document_graph.hpp>
 #include <document_graph/util.hpp>
@@ -98,27 +102,384 @@ namespace pricing {
                           eosio::const_mem_fun<NameToID, uint64_t, &NameToID::by_id>>>
               member_table;
 
+      //Payments made by a DAO, scoped by DAO id
       struct [[eosio::table, eosio::contract("dao")]] Payment
       {
          uint64_t payment_id;
          eosio::time_point payment_date;
+         //First and last period of the claim, the same period if only one was claimed
          uint64_t period_id = 0;
+         uint64_t last_period_id = 0;
          uint64_t assignment_id = -1;
          name recipient;
-         asset amount;
+         //Every token paid at once shares the row and the memo
+         std::vector<asset> amounts;
          string memo;
 
+         //Secondary keys include the payment id so pages can continue after a given payment
+         static uint128_t build_key(uint64_t value, uint64_t paymentID) {
+            return (static_cast<uint128_t>(value) << 64) | paymentID;
+         }
+
          uint64_t primary_key() const { return payment_id; }
-         uint64_t by_period() const { return period_id; }
-         uint64_t by_recipient() const { return recipient.value; }
-         uint64_t by_assignment() const { return assignment_id; }
+         uint128_t by_period() const { return build_key(period_id, payment_id); }
+         uint128_t by_recipient() const { return build_key(recipient.value, payment_id); }
+         uint128_t by_assignment() const { return build_key(assignment_id, payment_id); }
       };
       typedef multi_index<name("payments"), Payment,
-                          eosio::indexed_by<name("byperiod"), eosio::const_mem_fun<Payment, uint64_t, &Payment::by_period>>,
-                          eosio::indexed_by<name("byrecipient"), eosio::const_mem_fun<Payment, uint64_t, &Payment::by_recipient>>,
-                          eosio::indexed_by<name("byassignment"), eosio::const_mem_fun<Payment, uint64_t, &Payment::by_assignment>>>
+                          eosio::indexed_by<name("byperiod"), eosio::const_mem_fun<Payment, uint128_t, &Payment::by_period>>,
+                          eosio::indexed_by<name("byrecipient"), eosio::const_mem_fun<Payment, uint128_t, &Payment::by_recipient>>,
+                          eosio::indexed_by<name("byassignment"), eosio::const_mem_fun<Payment, uint128_t, &Payment::by_assignment>>>
           payment_table;
       
+      //Keeps track of the last claimed period of each assignment
+      //so the next claimable period can be found without walking the calendar
+      TABLE ClaimCursor
+      {
+         uint64_t assignment_id;
+         uint64_t last_period_id;
+         //Index of the last claimed period relative to the assignment start period
+         int64_t last_period_idx;
+         //End time of the period after last_period_id, 0 if it's not known yet
+         eosio::time_point_sec next_period_end;
+
+         uint64_t primary_key() const { return assignment_id; }
+      };
+
+      typedef multi_index<name("claimcursor"), ClaimCursor> claim_cursor_table;
+
+      //Compact index of the periods of each calendar, periods are still
+      //documents linked by NEXT edges but lookups by time or position use this table
+      TABLE CalendarPeriod
+      {
+         uint64_t period_id;
+         uint64_t calendar_id;
+         uint64_t period_index;
+         uint32_t start_sec;
+         //Start of the next period, 0 while this is the last period of the calendar
+         uint32_t end_sec;
+
+         static uint128_t build_key(uint64_t calendarID, uint64_t value) {
+            return (static_cast<uint128_t>(calendarID) << 64) | value;
+         }
+
+         uint64_t primary_key() const { return period_id; }
+         uint128_t by_index() const { return build_key(calendar_id, period_index); }
+         uint128_t by_start() const { return build_key(calendar_id, start_sec); }
+      };
+
+      typedef multi_index<name("calendar"), CalendarPeriod,
+                          eosio::indexed_by<name("byindex"), eosio::const_mem_fun<CalendarPeriod, uint128_t, &CalendarPeriod::by_index>>,
+                          eosio::indexed_by<name("bystart"), eosio::const_mem_fun<CalendarPeriod, uint128_t, &CalendarPeriod::by_start>>>
+              calendar_table;
+
+      //Commitment history of each assignment, scoped by assignment id.
+      //Rows are only appended and start times are strictly increasing
+      TABLE TimeShareEntry
+      {
+         uint64_t start_sec;
+         int64_t time_share;
+         uint64_t time_share_id;
+
+         uint64_t primary_key() const { return start_sec; }
+      };
+
+      typedef multi_index<name("timeline"), TimeShareEntry> time_share_table;
+
+      //Upvote election votes, one row per voter and election group
+      TABLE UpvoteVote
+      {
+         uint64_t id;
+         uint64_t group_id;
+         uint64_t voter_id;
+         uint64_t voted_id;
+
+         static uint128_t build_key(uint64_t groupID, uint64_t value) {
+            return (static_cast<uint128_t>(groupID) << 64) | value;
+         }
+
+         uint64_t primary_key() const { return id; }
+         uint128_t by_group_voter() const { return build_key(group_id, voter_id); }
+         uint128_t by_group_voted() const { return build_key(group_id, voted_id); }
+      };
+
+      typedef multi_index<name("upvotes"), UpvoteVote,
+                          eosio::indexed_by<name("bygroupvoter"), eosio::const_mem_fun<UpvoteVote, uint128_t, &UpvoteVote::by_group_voter>>,
+                          eosio::indexed_by<name("bygroupvoted"), eosio::const_mem_fun<UpvoteVote, uint128_t, &UpvoteVote::by_group_voted>>>
+              upvote_vote_table;
+
+      struct UpvoteCount
+      {
+         uint64_t member_id;
+         uint32_t votes;
+         bool self_voted;
+      };
+
+      //Running tally of each election group so casting a vote
+      //doesn't need to read every other vote of the group
+      TABLE UpvoteTally
+      {
+         uint64_t group_id;
+         std::vector<UpvoteCount> counts;
+         //Current group winner, -1 if there is none
+         int64_t winner = -1;
+
+         uint64_t primary_key() const { return group_id; }
+      };
+
+      typedef multi_index<name("upvotetally"), UpvoteTally> upvote_tally_table;
+
+      //Summary of the ballot of each published proposal, so closing
+      //a proposal doesn't need to read the tally, vetoes or voice supply
+      TABLE ProposalBallot
+      {
+         uint64_t proposal_id;
+         asset pass;
+         asset abstain;
+         asset fail;
+         uint32_t vetoes;
+         //Voice supply when the proposal was published
+         asset supply;
+
+         uint64_t primary_key() const { return proposal_id; }
+      };
+
+      typedef multi_index<name("ballots"), ProposalBallot> ballot_table;
+
+      //Current vote document of each voter on a proposal
+      TABLE ProposalVote
+      {
+         uint64_t id;
+         uint64_t proposal_id;
+         uint64_t voter_id;
+         uint64_t vote_id;
+
+         static uint128_t build_key(uint64_t proposalID, uint64_t voterID) {
+            return (static_cast<uint128_t>(proposalID) << 64) | voterID;
+         }
+
+         uint64_t primary_key() const { return id; }
+         uint128_t by_proposal_voter() const { return build_key(proposal_id, voter_id); }
+      };
+
+      typedef multi_index<name("propvotes"), ProposalVote,
+                          eosio::indexed_by<name("bypropvoter"), eosio::const_mem_fun<ProposalVote, uint128_t, &ProposalVote::by_proposal_voter>>>
+              proposal_vote_table;
+
+      //Progress of the votes index of each proposal
+      TABLE VoteIndexProposal
+      {
+         uint64_t proposal_id;
+         //Number of voters in the votes index
+         uint64_t voters;
+         //True once every vote of the proposal is in the votes index
+         bool complete;
+
+         uint64_t primary_key() const { return proposal_id; }
+      };
+
+      typedef multi_index<name("voteidxprops"), VoteIndexProposal> vote_index_proposal_table;
+
+      //Voice power of each voter taken at their first vote, scoped by proposal id
+      TABLE VoterPower
+      {
+         uint64_t voter_id;
+         asset power;
+
+         uint64_t primary_key() const { return voter_id; }
+      };
+
+      typedef multi_index<name("voterpower"), VoterPower> voter_power_table;
+
+      //Membership flags of each account in a DAO, scoped by DAO id
+      TABLE Membership
+      {
+         name account;
+         uint64_t member_id;
+         //Combination of membership::CORE, COMMUNITY and APPLICANT
+         uint8_t flags;
+
+         uint64_t primary_key() const { return account.value; }
+         uint64_t by_member() const { return member_id; }
+      };
+
+      typedef multi_index<name("membership"), Membership,
+                          eosio::indexed_by<name("bymember"), eosio::const_mem_fun<Membership, uint64_t, &Membership::by_member>>>
+              membership_table;
+
+      TABLE MembershipStats
+      {
+         uint64_t dao_id;
+         uint64_t core_members;
+         uint64_t community_members;
+         uint64_t applicants;
+         //False until all the existing members of the DAO were added to the membership table
+         bool indexed;
+
+         uint64_t primary_key() const { return dao_id; }
+      };
+
+      typedef multi_index<name("memberstats"), MembershipStats> membership_stats_table;
+
+      //Active system badges of each member, scoped by DAO id
+      TABLE MemberBadges
+      {
+         uint64_t member_id;
+         //One bit per badges::common::SystemBadgeType
+         uint16_t mask;
+
+         uint64_t primary_key() const { return member_id; }
+      };
+
+      typedef multi_index<name("memberbadges"), MemberBadges> member_badges_table;
+
+      //DAOs whose member badges table was already built from the badge edges
+      TABLE BadgeIndexDao
+      {
+         uint64_t dao_id;
+
+         uint64_t primary_key() const { return dao_id; }
+      };
+
+      typedef multi_index<name("badgedaos"), BadgeIndexDao> badge_index_dao_table;
+
+      //Reaction of each member to a likeable document
+      TABLE MemberReaction
+      {
+         uint64_t id;
+         uint64_t likeable_id;
+         uint64_t member_id;
+         uint64_t reaction_id;
+         name type;
+
+         static uint128_t build_key(uint64_t likeableID, uint64_t memberID) {
+            return (static_cast<uint128_t>(likeableID) << 64) | memberID;
+         }
+
+         uint64_t primary_key() const { return id; }
+         uint128_t by_likeable_member() const { return build_key(likeable_id, member_id); }
+      };
+
+      typedef multi_index<name("reactions"), MemberReaction,
+                          eosio::indexed_by<name("bylikemember"), eosio::const_mem_fun<MemberReaction, uint128_t, &MemberReaction::by_likeable_member>>>
+              member_reaction_table;
+
+      //Number of reactions of each type, scoped by likeable document id
+      TABLE ReactionCount
+      {
+         name type;
+         uint64_t count;
+
+         uint64_t primary_key() const { return type.value; }
+      };
+
+      typedef multi_index<name("reactcounts"), ReactionCount> reaction_count_table;
+
+      //Comment sections being removed
+      TABLE SectionRemoval
+      {
+         uint64_t section_id;
+         //Path from the section to the next comment to visit, 
+         //nodes are removed once all their replies were removed
+         std::vector<uint64_t> stack;
+
+         uint64_t primary_key() const { return section_id; }
+      };
+
+      typedef multi_index<name("secremovals"), SectionRemoval> section_removal_table;
+
+      //Core members of a DAO ordered by the time they joined, scoped by DAO id
+      TABLE CoreMember
+      {
+         uint64_t member_id;
+         name account;
+         eosio::time_point joined;
+
+         static uint128_t build_key(const eosio::time_point& joined, uint64_t memberID) {
+            return (static_cast<uint128_t>(joined.time_since_epoch().count()) << 64) | memberID;
+         }
+
+         uint64_t primary_key() const { return member_id; }
+         uint128_t by_joined() const { return build_key(joined, member_id); }
+      };
+
+      typedef multi_index<name("coremembers"), CoreMember,
+                          eosio::indexed_by<name("byjoined"), eosio::const_mem_fun<CoreMember, uint128_t, &CoreMember::by_joined>>>
+              core_member_table;
+
+      //Pending removal of the members that exceed the plan of a DAO
+      TABLE MemberTrimJob
+      {
+         uint64_t dao_id;
+         uint64_t remaining;
+         //Members are removed starting from the newest, only members joined before cursor are left to visit
+         uint128_t cursor;
+         //Admins are only removed once there are no regular members left
+         bool admins;
+
+         uint64_t primary_key() const { return dao_id; }
+      };
+
+      typedef multi_index<name("trimjobs"), MemberTrimJob> member_trim_job_table;
+
+      //Treasury balance document of each member in a DAO
+      TABLE TreasuryBalance
+      {
+         uint64_t balance_id;
+         uint64_t owner_id;
+         uint64_t dao_id;
+
+         static uint128_t build_key(uint64_t ownerID, uint64_t daoID) {
+            return (static_cast<uint128_t>(ownerID) << 64) | daoID;
+         }
+
+         uint64_t primary_key() const { return balance_id; }
+         uint128_t by_owner_dao() const { return build_key(owner_id, dao_id); }
+      };
+
+      typedef multi_index<name("balances"), TreasuryBalance,
+                          eosio::indexed_by<name("byownerdao"), eosio::const_mem_fun<TreasuryBalance, uint128_t, &TreasuryBalance::by_owner_dao>>>
+              treasury_balance_table;
+
+      //Accounts allowed to manage the treasury of a DAO, scoped by DAO id
+      TABLE TreasuryAuth
+      {
+         name account;
+         //Combination of treasury::common::auth_roles::TREASURER and ADMIN
+         uint8_t roles;
+
+         uint64_t primary_key() const { return account.value; }
+      };
+
+      typedef multi_index<name("trsyauth"), TreasuryAuth> treasury_auth_table;
+
+      //DAOs whose treasury auth table was already built from the treasurer and admin edges
+      TABLE TreasuryAuthDao
+      {
+         uint64_t dao_id;
+
+         uint64_t primary_key() const { return dao_id; }
+      };
+
+      typedef multi_index<name("trsyauthdaos"), TreasuryAuthDao> treasury_auth_dao_table;
+
+      //Pricing plan in effect for each DAO with a plan manager. The plan
+      //stays in effect until valid_until, after that the billing chain has to be resolved again
+      TABLE DaoPlan
+      {
+         uint64_t dao_id;
+         uint64_t plan_id;
+         int64_t max_members;
+         eosio::time_point valid_until;
+
+         uint64_t primary_key() const { return dao_id; }
+         uint64_t by_plan() const { return plan_id; }
+      };
+
+      typedef multi_index<name("daoplans"), DaoPlan,
+                          eosio::indexed_by<name("byplan"), eosio::const_mem_fun<DaoPlan, uint64_t, &DaoPlan::by_plan>>>
+              dao_plan_table;
+
       // deferred actions table
 
       TABLE deferred_actions_table {
@@ -128,6 +489,10 @@ namespace pricing {
          name account;
          name action_name;
          std::vector<char> data;
+         //Times the action was moved to the dead letter table
+         eosio::binary_extension<uint32_t> retries;
+         //Times the action was claimed by executebatch without completing
+         eosio::binary_extension<uint32_t> attempts;
 
          uint64_t primary_key() const { return id; }
          uint64_t by_execute_time() const { return execute_time.sec_since_epoch(); }
@@ -137,6 +502,21 @@ namespace pricing {
          eosio::indexed_by<"bytime"_n, eosio::const_mem_fun<deferred_actions_table, uint64_t, &deferred_actions_table::by_execute_time>>
       > deferred_actions_tables;
 
+      // deferred actions that failed, kept until they are retried or dropped
+      TABLE dead_actions_table {
+         uint64_t id;
+         eosio::time_point_sec execute_time;
+         eosio::time_point_sec failed_time;
+         std::vector<eosio::permission_level> auth;
+         name account;
+         name action_name;
+         std::vector<char> data;
+         uint32_t retries;
+
+         uint64_t primary_key() const { return id; }
+      };
+      typedef multi_index<"deadactions"_n, dead_actions_table> dead_actions_tables;
+
       
       // deferred actions test - remove
       TABLE testdtrx_table {
@@ -153,7 +533,10 @@ namespace pricing {
 
       ACTION propose(uint64_t dao_id, const name &proposer, const name &proposal_type, ContentGroups &content_groups, bool publish);
       ACTION vote(const name& voter, uint64_t proposal_id, string &vote, const std::optional<string> & notes);
+      ACTION indexvotes(uint64_t proposal_id, std::vector<uint64_t> vote_ids);
+      ACTION clearvotes(uint64_t proposal_id);
       ACTION closedocprop(uint64_t proposal_id);
+      ACTION rebuildtally(uint64_t proposal_id);
       ACTION delasset(uint64_t asset_id);
 
       ACTION proposepub(const name &proposer, uint64_t proposal_id);
@@ -164,6 +547,7 @@ namespace pricing {
       ACTION cmntadd(const name &author, const string content, const uint64_t comment_or_section_id);
       ACTION cmntupd(const string new_content, const uint64_t comment_id);
       ACTION cmntrem(const uint64_t comment_id);
+      ACTION cmntsecrem(uint64_t section_id);
 
       // reaction related
       ACTION reactadd(const name &user, const name &reaction, const uint64_t document_id);
@@ -192,9 +576,11 @@ namespace pricing {
       //Removes a dho/contract level setting
       //ACTION remsetting(const string &key);
 
-      ACTION genperiods(uint64_t dao_id, int64_t period_count/*, int64_t period_duration_sec*/);
+      //max_per_call is optional so callers using the previous signature keep working
+      ACTION genperiods(uint64_t dao_id, int64_t period_count, const eosio::binary_extension<int64_t>& max_per_call);
 
       ACTION claimnextper(uint64_t assignment_id);
+      ACTION claimperiods(uint64_t assignment_id, int64_t max_periods);
       // ACTION simclaimall(name account, uint64_t dao_id, bool only_ids);
       // ACTION simclaim(uint64_t assignment_id);
 
@@ -230,11 +616,29 @@ namespace pricing {
       ACTION createcalen(bool is_default);
 
       ACTION initcalendar(uint64_t calendar_id, uint64_t next_period);
+
+      ACTION indexcalen(uint64_t calendar_id);
+
+      ACTION indexmembers(uint64_t dao_id, name from);
+      ACTION indexbadges(uint64_t dao_id, name from);
       
       ACTION reset(); // debugging - maybe with the dev flags
 
+      /**
+       * @brief Returns up to limit payments of the DAO with the given key in the index
+       * (byperiod, byrecipient or byassignment) starting at payment from_id,
+       * claims of several periods are found by their first period.
+       * It doesn't modify any state, meant to be called in read only transactions
+       */
+      [[eosio::action]] std::vector<Payment> getpayments(uint64_t dao_id, name index, uint64_t key, uint64_t from_id, uint64_t limit);
+
       ACTION executenext(); // execute stored deferred actions
-      ACTION removedtx(); // delete stalled deferred action
+      [[eosio::action]] std::vector<uint64_t> executebatch(uint64_t max_actions); // claim up to max_actions due deferred actions
+      ACTION executedtx(uint64_t id); // execute a claimed deferred action in its own transaction
+      ACTION removedtx(); // move stalled deferred action to the dead letter table
+      ACTION deadlettrx(uint64_t id); // move a failing deferred action to the dead letter table
+      ACTION retrydtx(uint64_t id); // schedule a dead letter action again
+      ACTION dropdtx(uint64_t id); // delete a dead letter action
 
       // Actions for testing deferred transactions - only for unit tests
       // ACTION addtest(eosio::time_point_sec execute_time, uint64_t number, std::string text);
@@ -301,6 +705,12 @@ namespace pricing {
 
       Settings* getSettingsDocument(uint64_t daoID);
 
+      /**
+       * @brief Returns the account stored in the given DHO setting
+       * e.g. GOVERNANCE_TOKEN_CONTRACT, it's only looked up once per action
+       */
+      const eosio::name& getContractName(const std::string& setting);
+
       template <class T>
       const T& getSettingOrFail(const std::string &setting)
       {
@@ -368,6 +778,8 @@ namespace pricing {
       ACTION cancmsigpay(name treasurer, uint64_t msig_id);
       ACTION setpaynotes(uint64_t payment_id, string notes);
       ACTION setrsysttngs(uint64_t treasury_id, const std::map<std::string, Content::FlexValue>& kvs, std::optional<std::string> group);
+      ACTION indexbals(uint64_t from_edge_id);
+      ACTION idxtrsyauth(uint64_t treasury_id);
 #endif
 #ifdef USE_UPVOTE_ELECTIONS
       //Upvote System
@@ -411,6 +823,7 @@ namespace pricing {
       ACTION updatecurbil(uint64_t dao_id);
       ACTION activatedao(eosio::name dao_name);
       ACTION addtype(uint64_t dao_id, const std::string& dao_type);
+      ACTION trimmembers(uint64_t dao_id);
 #endif
       ACTION activatebdg(uint64_t assign_badge_id);
 
@@ -421,6 +834,31 @@ namespace pricing {
                        const eosio::name &paymentType,
                        const AssetBatch& daoTokens);
 
+      /**
+       * @brief Pays every token of the batch to the recipient and records a single row
+       * in the payments table. Unless the DAO disabled payment receipts, a single receipt
+       * document is also linked with one PAYMENT and one PAID edge
+       */
+      void makePayments(Settings* daoSettings, uint64_t fromNode, const eosio::name &recipient,
+                        const AssetBatch& amounts, const string &memo,
+                        const eosio::name &paymentType,
+                        const AssetBatch& daoTokens,
+                        uint64_t periodID = 0,
+                        uint64_t lastPeriodID = 0,
+                        uint64_t assignmentID = -1);
+
+      /**
+       * @brief Records the payment in the payments table of the DAO and creates the 
+       * receipt document if the DAO didn't disable them, returns the receipt id if created
+       */
+      std::optional<uint64_t> recordPayments(Settings* daoSettings, const eosio::name &recipient,
+                                             const std::vector<eosio::asset>& amounts,
+                                             const string &memo,
+                                             ContentGroups receipt,
+                                             uint64_t periodID = 0,
+                                             uint64_t lastPeriodID = 0,
+                                             uint64_t assignmentID = -1);
+
       void modifyCommitment(RecurringActivity& assignment,
                             int64_t commitment,
                             std::optional<eosio::time_point> fixedStartDate,
@@ -464,9 +902,8 @@ namespace pricing {
       [[eosio::on_notify("*::transfer")]]
       void ontransfer(const name& from, const name& to, const asset& quantity, const string& memo) {
 
-         auto settings = getSettingsDocument();
-         auto pegContract = settings->getOrFail<name>(PEG_TOKEN_CONTRACT);
-         auto rewardContract = settings->getOrFail<name>(REWARD_TOKEN_CONTRACT);
+         auto pegContract = getContractName(PEG_TOKEN_CONTRACT);
+         auto rewardContract = getContractName(REWARD_TOKEN_CONTRACT);
 
          if (get_first_receiver() == pegContract &&
              to == get_self() &&
@@ -550,18 +987,33 @@ namespace pricing {
 
       void schedule_deferred_action(eosio::time_point_sec execute_time, eosio::action action);
 
+      bool isTreasuryAuthCached(uint64_t treasuryID) const
+      {
+         return m_context.authorizedTreasuries.count(treasuryID) > 0;
+      }
+
+      void cacheTreasuryAuth(uint64_t treasuryID)
+      {
+         m_context.authorizedTreasuries.insert(treasuryID);
+      }
+
    private:
 
+      void runDeferred(const deferred_actions_table& deferred);
+      void deadLetter(deferred_actions_tables& deftrx, deferred_actions_tables::const_iterator itr);
+
       void onRewardTransfer(const name& from, const name& to, const asset& amount);
 
       //AssetBatch calculatePendingClaims(uint64_t assignmentID, const AssetBatch& daoTokens);
 
+      void claimPeriods(uint64_t assignmentID, int64_t maxPeriods);
+
       AssetBatch calculatePeriodPayout(Period& period,
                                        const AssetBatch& salary,
                                        const AssetBatch& daoTokens, 
-                                       std::optional<TimeShare>& nextTimeShareOpt,
-                                       std::optional<TimeShare>& lastUsedTimeShare,
-                                       int64_t initTimeShare);
+                                       uint64_t assignmentID,
+                                       int64_t initTimeShare,
+                                       uint64_t& lastUsedTimeShare);
 
       void onCashTokenTransfer(uint64_t dao_id, const name& from, const name& to, const asset& quantity, const string& memo);
 
@@ -604,15 +1056,32 @@ namespace pricing {
 
       DocumentGraph m_documentGraph = DocumentGraph(get_self());
 
-      void genPeriods(const std::string& owner, int64_t periodDuration, uint64_t ownerId, uint64_t calendarId, int64_t periodCount/*, int64_t period_duration_sec*/);
-
-      asset getProRatedAsset(ContentWrapper *assignment, const symbol &symbol,
-                             const string &key, const float &proration);
+      void genPeriods(const std::string& owner, int64_t periodDuration, uint64_t ownerId, uint64_t calendarId, int64_t periodCount, int64_t maxPerCall);
 
       std::vector<Document> getCurrentBadges(Period& period, const eosio::name &member, uint64_t dao);
 
       bool isPaused();
 
+      /**
+       * @brief Drops the cached values resolved from the root settings so the 
+       * next reads in the same action see the updated settings
+       */
+      void resetRootSettingsContext();
+
       std::vector<std::unique_ptr<Settings>> m_settingsDocs;
+
+      //Values that are looked up by most actions, resolved the first time they are
+      //needed. The contract object only lives for a single action so they can't go stale
+      struct ActionContext
+      {
+         std::optional<uint64_t> rootID;
+         Settings* dhoSettings = nullptr;
+         std::optional<bool> paused;
+         std::map<std::string, eosio::name> contracts;
+         //Treasuries whose treasurer permissions were already verified
+         std::set<uint64_t> authorizedTreasuries;
+      };
+
+      mutable ActionContext m_context;
    };
 } // namespace hypha
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <eosio/asset.hpp>
+#include <eosio/symbol.hpp>
+
+namespace hypha::fixed
+{
+    //Powers of ten up to the max precision of a symbol
+    inline constexpr std::array<int64_t, 19> POW10 = {
+        1LL,
+        10LL,
+        100LL,
+        1000LL,
+        10000LL,
+        100000LL,
+        1000000LL,
+        10000000LL,
+        100000000LL,
+        1000000000LL,
+        10000000000LL,
+        100000000000LL,
+        1000000000000LL,
+        10000000000000LL,
+        100000000000000LL,
+        1000000000000000LL,
+        10000000000000000LL,
+        100000000000000000LL,
+        1000000000000000000LL
+    };
+
+    /**
+     * @brief Returns 10^exp, fails if it doesn't fit in 64 bits
+     */
+    int64_t pow10(uint8_t exp);
+
+    /**
+     * @brief Returns value * num / den using 128 bit intermediates,
+     * the result is truncated towards zero and must fit in 64 bits
+     */
+    int64_t mulDiv(int64_t value, int64_t num, int64_t den);
+
+    /**
+     * @brief Returns the amount multiplied by num / den, keeping its symbol
+     */
+    eosio::asset scale(const eosio::asset& amount, int64_t num, int64_t den);
+
+    /**
+     * @brief Returns the amount multiplied by num / den in the given symbol,
+     * adjusting for the difference of precision i.e. 1.25 USD * 4 / 5 -> 1.0000 HYPHA
+     */
+    eosio::asset convert(const eosio::asset& amount, const eosio::symbol& symbol, int64_t num = 1, int64_t den = 1);
+
+    /**
+     * @brief Returns the given number of whole units of symbol i.e. 3 -> 3.00 USD
+     */
+    eosio::asset units(int64_t count, const eosio::symbol& symbol);
+}
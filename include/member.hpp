@@ -4,11 +4,19 @@
 
 #include <document_graph/document.hpp>
 
+#include <optional>
+
 namespace hypha
 {
 
     class dao;
 
+    namespace membership {
+        inline constexpr uint8_t CORE = 1 << 0;
+        inline constexpr uint8_t COMMUNITY = 1 << 1;
+        inline constexpr uint8_t APPLICANT = 1 << 2;
+    }
+
     class Member : public Document
     {
     public:
@@ -31,8 +39,36 @@ namespace hypha
         void checkMembershipOrEnroll(uint64_t daoID);
 
         void removeMembershipFromDao(uint64_t daoID);
+
+        /**
+         * @brief Sets or clears a membership flag of the account in the membership
+         * table of the DAO and updates the DAO member counters
+         */
+        static void setMembership(dao& dao, uint64_t daoID, const eosio::name& account, uint8_t flag, bool value);
+
+        /**
+         * @brief Returns the number of core plus community members of the DAO,
+         * or nothing if the DAO membership table isn't indexed yet
+         */
+        static std::optional<uint64_t> getMemberCount(dao& dao, uint64_t daoID, uint8_t flags);
+
+        /**
+         * @brief Marks the membership table of a new DAO as indexed
+         */
+        static void initMembershipIndex(dao& dao, uint64_t daoID);
+
+        /**
+         * @brief Adds up to maxMembers accounts starting at from to the membership table
+         * of the DAO based on their membership edges. Returns the account to continue from
+         * or nothing once all the accounts were processed
+         */
+        static std::optional<eosio::name> indexMembership(dao& dao, uint64_t daoID, const eosio::name& from, size_t maxMembers);
     private: 
         static ContentGroups defaultContent (const eosio::name &member);
+        static std::optional<bool> hasMembership(dao& dao, uint64_t daoID, const eosio::name& account, uint8_t flag);
+        static uint8_t indexAccount(dao& dao, uint64_t daoID, const eosio::name& account, uint64_t memberID);
+        static void writeMembership(dao& dao, uint64_t daoID, const eosio::name& account, uint64_t memberID, uint8_t flags);
+        static void writeCoreMember(dao& dao, uint64_t daoID, const eosio::name& account, uint64_t memberID, bool isCore, const eosio::time_point& joined);
         dao& m_dao;
     };
 } // namespace hypha
\ No newline at end of file
@@ -16,19 +16,28 @@ namespace hypha
         Payer(dao &dao, Settings* daoSettings);
         virtual ~Payer();
 
-        Document pay(const eosio::name &recipient,
-                     const eosio::asset &quantity,
-                     const string &memo);
+        void pay(const eosio::name &recipient,
+                 const eosio::asset &quantity,
+                 const string &memo);
 
         static ContentGroups defaultReceipt(const eosio::name &recipient,
                                             const eosio::asset &quantity,
                                             const string &memo,
                                             uint64_t dao_id);
 
+        /**
+         * @brief Receipt of the payment of several tokens at once, 
+         * each paid token has its own item (reward_amount, peg_amount and voice_amount)
+         */
+        static ContentGroups batchReceipt(const eosio::name &recipient,
+                                          const AssetBatch &amounts,
+                                          const string &memo,
+                                          uint64_t dao_id);
+
     protected:
-        virtual Document payImpl(const eosio::name &recipient,
-                                 const eosio::asset &quantity,
-                                 const string &memo) = 0;
+        virtual void payImpl(const eosio::name &recipient,
+                             const eosio::asset &quantity,
+                             const string &memo) = 0;
 
         void issueToken(const name &token_contract,
                         const name &issuer,
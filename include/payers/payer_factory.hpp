@@ -3,6 +3,8 @@
 #include <eosio/name.hpp>
 #include <eosio/symbol.hpp>
 
+#include <memory>
+
 #include "payer.hpp"
 
 namespace hypha {
@@ -12,7 +14,7 @@ namespace hypha {
     class PayerFactory
     {
     public:
-        static Payer* Factory(dao &dao, Settings* daoSettings, const eosio::symbol &symbol, const eosio::name &paymentType, const AssetBatch& daoTokens);
+        static std::unique_ptr<Payer> Factory(dao &dao, Settings* daoSettings, const eosio::symbol &symbol, const eosio::name &paymentType, const AssetBatch& daoTokens);
     };
 }
 
@@ -15,13 +15,9 @@ namespace hypha
     public:
         using Payer::Payer;
 
-        Document pay(const eosio::name &recipient,
-                      const eosio::asset &quantity,
-                      const string &memo);
-
     protected:
-        Document payImpl(const eosio::name &recipient,
-                          const eosio::asset &quantity,
-                          const string &memo) override;
+        void payImpl(const eosio::name &recipient,
+                     const eosio::asset &quantity,
+                     const string &memo) override;
     };
 } // namespace hypha
\ No newline at end of file
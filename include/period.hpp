@@ -49,6 +49,15 @@ namespace hypha
         static Period current(dao *dao, uint64_t daoID);
         bool isEnd();
 
+        uint64_t getCalendarID();
+
+        /**
+         * @brief Adds the period to the calendar index right after prevPeriodID,
+         * or as the first period of the calendar if prevPeriodID is empty.
+         * Nothing is done if the previous period isn't indexed yet (see indexcalen)
+         */
+        static void appendToCalendar(dao *dao, uint64_t calendarID, std::optional<uint64_t> prevPeriodID, Period& period);
+
         dao *m_dao;
     };
 } // namespace hypha
\ No newline at end of file
@@ -21,6 +21,15 @@ void checkDaoCanEnrrollMember(dao& dao, uint64_t daoID);
  * @param daoID 
  */
 void onDaoPlanChange(dao& dao, uint64_t daoID, PricingPlan& newPlan);
+
+/**
+ * @brief Removes a page of the members that exceed the plan of the DAO, starting 
+ * from the most recent ones. Schedules itself until no members are left to remove
+ * 
+ * @param dao 
+ * @param daoID 
+ */
+void trimMembers(dao& dao, uint64_t daoID);
 #endif
 
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <optional>
+#include <utility>
 
 #include <typed_document.hpp>
 #include <macros.hpp>
@@ -36,6 +37,24 @@ public:
 
     eosio::asset calculateCredit();
 
+    /**
+     * @brief Walks the billing chain starting at the current bill to find the plan in effect
+     * 
+     * @return The plan in effect and the time until it stays in effect
+     */
+    std::pair<PricingPlan, eosio::time_point> resolveCurrentPlan();
+
+    /**
+     * @brief Stores the plan in effect in the DAO plans table
+     */
+    void updatePlanCache();
+
+    /**
+     * @brief Max member count of the plan in effect for the DAO if it's cached 
+     * and still valid
+     */
+    static std::optional<int64_t> getCachedMaxMembers(dao& dao, uint64_t daoID);
+
     static std::optional<PlanManager> getFromDaoIfExists(dao& dao, uint64_t daoID);
 
     static PlanManager getFromDaoID(dao& dao, uint64_t daoID);
@@ -57,6 +57,10 @@ namespace hypha
         ContentGroup makeBallotOptionsGroup();
 
         bool didPass(Document& proposal, uint64_t tallyHash);
+        bool didPass(const eosio::asset& voiceSupply,
+                     const eosio::asset& votesPass,
+                     const eosio::asset& votesAbstain,
+                     const eosio::asset& votesFail);
 
         string getTitle(ContentWrapper cw) const;
         string getDescription(ContentWrapper cw) const;
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+#include <eosio/asset.hpp>
+
+namespace hypha
+{
+    struct AssetBatch
+    {
+      eosio::asset reward;
+      eosio::asset peg;
+      eosio::asset voice;
+    };
+
+    AssetBatch& operator+=(AssetBatch& self, const AssetBatch& other);
+
+    struct SalaryConfig
+    {
+      //Salary per period in USD at full time share
+      eosio::asset periodSalary;
+      //Percentages in base 100
+      int64_t timeShare = 100;
+      int64_t deferredPerc;
+      //Multipliers in base 100 i.e. 200 is 2.0
+      int64_t voiceMultipler = 200;
+      int64_t rewardMultipler = 100;
+      int64_t pegMultipler = 100;
+    };
+
+    AssetBatch calculateSalaries(const SalaryConfig& salaryConf, const AssetBatch& tokens);
+}
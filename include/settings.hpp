@@ -1,6 +1,7 @@
 #pragma once
 
 #include <map>
+#include <array>
 
 #include <document_graph/document.hpp>
 #include <logger/logger.hpp>
@@ -77,10 +78,11 @@ public:
     std::optional<T> getSettingOpt(const std::string& key)
     {
         TRACE_FUNCTION()
-        auto [idx, content] = getContentWrapper().get(SETTINGS_IDX, key);
-        if (auto p = std::get_if<T>(&content->value))
-        {
-            return *p;
+        if (auto content = findSetting(SETTINGS_IDX, key)) {
+            if (auto p = std::get_if<T>(&content->value))
+            {
+                return *p;
+            }
         }
 
         return {};
@@ -90,7 +92,12 @@ public:
     const T& getOrFail(const std::string& group, const string& key)
     {
         TRACE_FUNCTION()
-        auto content = getContentWrapper().getOrFail(group, key, "setting " + key + " does not exist in " + group);
+        auto content = findSetting(group, key);
+
+        EOS_CHECK(
+            content != nullptr,
+            "setting " + key + " does not exist in " + group
+        )
 
         if (auto p = std::get_if<T>(&content->value)) {
             return *p;
@@ -124,12 +131,60 @@ public:
         return def;
     }
 
+    /** @brief Typed accessors for the settings read by most voting and payment actions,
+    * their positions are resolved once when the settings index is built
+    */
+    const eosio::asset& getVoiceToken();
+    eosio::asset getRewardToken();
+    eosio::asset getPegToken();
+    const eosio::name& getDaoName();
+    int64_t getQuorumFactor();
+    int64_t getAlignmentFactor();
+
     //Default index for settings group
     static constexpr int64_t SETTINGS_IDX = 0;
 private:
+    /**
+     * @brief Finds a setting through an index of (group, key) -> position built
+     * on first use. The index is validated against the shape of the content groups
+     * on each lookup, so it's rebuilt if the content was modified in between.
+     * 
+     * @return Pointer to the setting or nullptr if it doesn't exist
+     */
+    Content* findSetting(int64_t groupIdx, const std::string& key);
+    Content* findSetting(const std::string& group, const std::string& key);
+
+    enum HotSetting : size_t
+    {
+        HOT_VOICE_TOKEN,
+        HOT_REWARD_TOKEN,
+        HOT_PEG_TOKEN,
+        HOT_DAO_NAME,
+        HOT_QUORUM_FACTOR,
+        HOT_ALIGNMENT_FACTOR,
+        HOT_SETTINGS_COUNT
+    };
+
+    /**
+     * @brief Returns the setting at the position resolved by the last index build,
+     * or nullptr if it doesn't exist or moved since then
+     */
+    Content* findHotSetting(HotSetting setting);
+
+    bool isIndexStale();
+    void buildIndex();
+    void invalidateIndex();
+
     //bool m_dirty;
     uint64_t m_rootID;
     dao* m_dao;
+
+    bool m_indexed = false;
+    std::map<std::string, int64_t, std::less<>> m_groupIndex;
+    std::vector<std::map<std::string, size_t, std::less<>>> m_itemIndex;
+    std::vector<size_t> m_groupSizes;
+    //Position of each hot setting in the settings group, -1 if it doesn't exist
+    std::array<int64_t, HOT_SETTINGS_COUNT> m_hotSettings;
 };
 
 }
\ No newline at end of file
@@ -29,6 +29,25 @@ public:
   std::optional<TimeShare> getNext();
 
   time_point getStartDate();
+
+  int64_t getTimeShare();
+
+  /**
+  * Appends this time share to the timeline of its assignment
+  */
+  void addToTimeline(uint64_t assignment);
+
+  /**
+  * Fills the timeline of an assignment from its time share documents,
+  * only needed for assignments created before the timeline existed
+  */
+  static void initTimeline(name contract, uint64_t assignment);
+
+  /**
+  * Erases the timeline of an assignment, it is rebuilt by initTimeline
+  * if the assignment is still in use
+  */
+  static void eraseTimeline(name contract, uint64_t assignment);
 private:
 
   ContentGroups constructContentGroups(int64_t timeShare, time_point startDate, uint64_t assignment);
@@ -34,10 +34,21 @@ public:
 
     static Balance getOrCreate(dao& dao, uint64_t daoID, uint64_t owner);
 
+    /**
+     * @brief Adds the balances linked by redeembal edges to the balances table, walking
+     * the edge name index starting at the edge fromEdgeID (0 to start from the beginning).
+     * At most maxScanned edges are visited
+     * 
+     * @return Id of the edge to continue from or std::nullopt if there are no more edges
+     */
+    static std::optional<uint64_t> indexBalances(dao& dao, uint64_t fromEdgeID, size_t maxScanned);
+
     virtual const std::string buildNodeLabel(ContentGroups &content) override
     {
         return "Balance";
     }
+private:
+    static void addToIndex(dao& dao, uint64_t balanceID, uint64_t owner, uint64_t daoID);
 };
 
 using BalanceData = Balance::Data;
@@ -41,6 +41,11 @@ namespace fields {
     inline constexpr auto PAYMENT_STATE = "state";
 }
 
+namespace auth_roles {
+    inline constexpr uint8_t TREASURER = 1;
+    inline constexpr uint8_t ADMIN = 2;
+}
+
 namespace payment_state {
     inline constexpr auto NONE = "none";
     inline constexpr auto PENDING = "pending";
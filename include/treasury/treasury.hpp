@@ -60,6 +60,18 @@ public:
 
     void checkTreasurerAuth();
 
+    /**
+     * @brief Rebuilds the auth table of the DAO from the treasurer and admin edges
+     */
+    void indexAuth();
+
+    /**
+     * @brief Adds or removes a role of the account in the treasury auth table of the DAO
+     * 
+     * @param role One of common::auth_roles
+     */
+    static void setAuthRole(dao& dao, uint64_t daoID, const eosio::name& account, uint8_t role, bool enabled);
+
     static Treasury getFromDaoID(dao& dao, uint64_t daoID);
 };
 
@@ -32,6 +32,10 @@ public:
     bool isElectionRoundMember(uint64_t accountId);
     void vote(int64_t from, int64_t to);
 
+    //Removes the votes of the group once its election is over,
+    //the tally is kept as the summary of the group votes
+    void eraseVotes();
+
 private:
     virtual const std::string buildNodeLabel(ContentGroups &content) override
     {
@@ -28,6 +28,8 @@ public:
 
     std::vector<uint64_t> getWinners();
 
+    void eraseVotes();
+
     void setNextRound(ElectionRound* nextRound) const;
     std::unique_ptr<ElectionRound> getNextRound() const;
     
@@ -23,7 +23,6 @@ class UpVoteVote : public TypedDocument
 
 public:
     UpVoteVote(dao& dao, uint64_t id);
-    UpVoteVote(dao& dao, uint64_t group_id, Data data);
 
     uint64_t getElectionGroup();
     
@@ -15,6 +15,7 @@
 #include <document_graph/content_wrapper.hpp>
 #include <document_graph/util.hpp>
 #include <settings.hpp>
+#include <salary.hpp>
 
 namespace hypha
 {
@@ -25,39 +26,12 @@ namespace hypha
       //using property_map
     }
 
-    struct AssetBatch
-    {
-      eosio::asset reward;
-      eosio::asset peg;
-      eosio::asset voice;
-    };
-
-    AssetBatch& operator+=(AssetBatch& self, const AssetBatch& other);
-
-    struct SalaryConfig
-    {
-      // double annualSalary;
-      double periodSalary;
-      double deferredPerc;
-      double voiceMultipler = 2.0;
-      double rewardMultipler = 1.0;
-      double pegMultipler = 1.0;
-    };
-
-    /**
-     * @brief Gets the phase to year ratio using the dao setting variable for the period duration
-     * 
-     * @param daoSettings 
-     * @return Phase to year ratio 
-     */
-    float getPhaseToYearRatio(Settings* daoSettings);
-    float getPhaseToYearRatio(Settings* daoSettings, int64_t periodDuration);
-
-    AssetBatch calculateSalaries(const SalaryConfig& salaryConf, const AssetBatch& tokens);
-
     ContentGroups getRootContent(const eosio::name &contract);
     ContentGroups getDAOContent(const eosio::name &dao_name, string daoType);
-    eosio::asset adjustAsset(const eosio::asset &originalAsset, const float &adjustment);
+    /**
+     * @brief Returns the asset multiplied by numerator / denominator
+     */
+    eosio::asset adjustAsset(const eosio::asset &originalAsset, int64_t numerator, int64_t denominator);
 
     int64_t stringViewToInt(string_view str);
 
@@ -65,7 +39,10 @@ namespace hypha
 
     vector<string_view> splitStringView(string_view str, char delimiter);
 
-    double getMultiplier(Settings* settings, const char* multiplierName, double defaultVal);
+    /**
+     * @brief Gets a multiplier setting in base 100 i.e. 200 is 2.0
+     */
+    int64_t getMultiplier(Settings* settings, const char* multiplierName, int64_t defaultVal);
 
     template<typename T>
     class ShowType;
@@ -150,10 +127,6 @@ namespace hypha
                           const eosio::asset &token_amount,
                           const string &memo);
 
-    double normalizeToken(const eosio::asset& token);
-
-    eosio::asset denormalizeToken(double amountNormalized, const eosio::asset& token);
-
     /**
      * @brief Returns the representation of 1 unit in the given token
      */
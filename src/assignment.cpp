@@ -34,6 +34,56 @@ namespace hypha
     }
 
     std::optional<Period> Assignment::getNextClaimablePeriod()
+    {
+        TRACE_FUNCTION()
+        dao::claim_cursor_table cursors(m_dao->get_self(), m_dao->get_self().value);
+
+        auto cursorIt = cursors.find(getID());
+
+        //Assignments without cursor have to walk the calendar from the start period
+        if (cursorIt == cursors.end()) {
+            return scanNextClaimablePeriod();
+        }
+
+        int64_t periodCount = getPeriodCount();
+        int64_t idx = cursorIt->last_period_idx + 1;
+
+        if (idx >= periodCount) {
+            return std::nullopt;
+        }
+
+        auto currentTime = eosio::current_time_point().sec_since_epoch();
+
+        auto cachedEnd = cursorIt->next_period_end.sec_since_epoch();
+
+        //Next period hasn't lapsed yet, no need to load any document
+        if (cachedEnd != 0 && cachedEnd > currentTime) {
+            return std::nullopt;
+        }
+
+        Period period = Period(m_dao, cursorIt->last_period_id).next();
+
+        //Older assignments might have periods claimed out of order
+        bool skipped = false;
+        while (isClaimed(&period)) {
+            if (++idx >= periodCount) {
+                return std::nullopt;
+            }
+            period = period.next();
+            skipped = true;
+        }
+
+        if ((cachedEnd == 0 || skipped) &&
+            period.getEndTime().sec_since_epoch() > currentTime) {
+            return std::nullopt;
+        }
+
+        m_nextClaimIdx = idx;
+
+        return std::optional<Period>{period};
+    }
+
+    std::optional<Period> Assignment::scanNextClaimablePeriod()
     {
         TRACE_FUNCTION()
         // Ensure that the claimed period is within the approved period count
@@ -49,6 +99,7 @@ namespace hypha
             if (endTime <= currentTime &&   // if period has lapsed
                 !isClaimed(&period))         // and not yet claimed
             {
+                m_nextClaimIdx = counter;
                 return std::optional<Period>{period};
             }
             period = period.next();
@@ -57,13 +108,61 @@ namespace hypha
         return std::nullopt;
     }
 
+    void Assignment::setClaimed(Period& period)
+    {
+        TRACE_FUNCTION()
+        EOS_CHECK(
+            m_nextClaimIdx >= 0,
+            "Next claimable period has to be resolved before claiming it"
+        );
+
+        Edge::write(m_dao->get_self(), m_dao->get_self(), getID(), period.getID(), common::CLAIMED);
+
+        //Cache the end time of the following period if the calendar already has it
+        eosio::time_point_sec nextEnd;
+
+        if (auto next = period.nextOpt()) {
+            if (auto nextNext = next->nextOpt()) {
+                nextEnd = eosio::time_point_sec(nextNext->getStartTime());
+            }
+        }
+
+        dao::claim_cursor_table cursors(m_dao->get_self(), m_dao->get_self().value);
+
+        auto setCursor = [&](dao::ClaimCursor& cursor) {
+            cursor.assignment_id = getID();
+            cursor.last_period_id = period.getID();
+            cursor.last_period_idx = m_nextClaimIdx;
+            cursor.next_period_end = nextEnd;
+        };
+
+        if (auto cursorIt = cursors.find(getID()); cursorIt != cursors.end()) {
+            cursors.modify(cursorIt, m_dao->get_self(), setCursor);
+        }
+        else {
+            cursors.emplace(m_dao->get_self(), setCursor);
+        }
+
+        m_nextClaimIdx = -1;
+    }
+
+    void Assignment::eraseClaimCursor(dao& dao, uint64_t assignmentID)
+    {
+        TRACE_FUNCTION()
+        dao::claim_cursor_table cursors(dao.get_self(), dao.get_self().value);
+
+        if (auto cursorIt = cursors.find(assignmentID); cursorIt != cursors.end()) {
+            cursors.erase(cursorIt);
+        }
+    }
+
     AssetBatch Assignment::getSalary() 
     {
       //Since multipliers can change from time to time, we need to recalculate salary using the latest values
       auto tokens = AssetBatch {
-          .reward = m_daoSettings->getSettingOrDefault<asset>(common::REWARD_TOKEN),
-          .peg = m_daoSettings->getSettingOrDefault<asset>(common::PEG_TOKEN),
-          .voice = m_daoSettings->getOrFail<asset>(common::VOICE_TOKEN)
+          .reward = m_daoSettings->getRewardToken(),
+          .peg = m_daoSettings->getPegToken(),
+          .voice = m_daoSettings->getVoiceToken()
       };
 
       auto cw = getContentWrapper();
@@ -76,11 +175,12 @@ namespace hypha
       int64_t deferred = cw.getOrFail(DETAILS, DEFERRED)->getAs<int64_t>();
 
       SalaryConfig salaryConf {
-          .periodSalary = normalizeToken(usdPerPeriod) * (initialTimeshare / 100.0),
-          .deferredPerc = deferred / 100.0,
-          .voiceMultipler = getMultiplier(m_daoSettings, common::VOICE_MULTIPLIER, 1.0),
-          .rewardMultipler = getMultiplier(m_daoSettings, common::REWARD_MULTIPLIER, 1.0),
-          .pegMultipler = getMultiplier(m_daoSettings, common::PEG_MULTIPLIER, 1.0)
+          .periodSalary = usdPerPeriod,
+          .timeShare = initialTimeshare,
+          .deferredPerc = deferred,
+          .voiceMultipler = getMultiplier(m_daoSettings, common::VOICE_MULTIPLIER, 100),
+          .rewardMultipler = getMultiplier(m_daoSettings, common::REWARD_MULTIPLIER, 100),
+          .pegMultipler = getMultiplier(m_daoSettings, common::PEG_MULTIPLIER, 100)
       };
 
       AssetBatch salary = calculateSalaries(salaryConf, tokens);
@@ -120,6 +120,9 @@ void onBadgeActivated(dao& dao, RecurringActivity& badgeAssign)
                 badgeAssign.getID(), 
                 common::links::ADMIN_BADGE
             );
+#ifdef USE_TREASURY
+            treasury::Treasury::setAuthRole(dao, badgeAssign.getDaoID(), assignee, treasury::common::auth_roles::ADMIN, true);
+#endif
         } break;
 #ifdef USE_TREASURY
         case SystemBadgeType::Treasurer: {
@@ -156,6 +159,8 @@ void onBadgeActivated(dao& dao, RecurringActivity& badgeAssign)
             EOS_CHECK(false, "Invalid system badge type");
             break;
         }
+
+        setSystemBadge(dao, badgeAssign.getDaoID(), mem.getID(), systemType, true);
     }
 }
 
@@ -185,6 +190,9 @@ void onBadgeArchived(dao& dao, RecurringActivity& badgeAssign)
             if (Edge::exists(dao.get_self(), memID, badgeAssign.getID(), common::links::ADMIN_BADGE)) {
                 Edge::get(dao.get_self(), memID, badgeAssign.getID(), common::links::ADMIN_BADGE).erase();
             }
+#ifdef USE_TREASURY
+            treasury::Treasury::setAuthRole(dao, badgeAssign.getDaoID(), assignee, treasury::common::auth_roles::ADMIN, false);
+#endif
         } break;
 #ifdef USE_TREASURY
         case SystemBadgeType::Treasurer: {
@@ -217,6 +225,8 @@ void onBadgeArchived(dao& dao, RecurringActivity& badgeAssign)
             EOS_CHECK(false, "Invalid system badge type");
             break;
         }
+
+        setSystemBadge(dao, badgeAssign.getDaoID(), memID, systemType, false);
     }
 }
 
@@ -231,44 +241,88 @@ Document getBadgeOf(dao& dao, uint64_t badgeAssignID)
     return Document(dao.get_self(), badgeEdge.getToNode());
 }
 
-static bool hasAdminBadge(dao& dao, uint64_t daoID, uint64_t memberID) 
+static uint16_t getBadgeBit(SystemBadgeType systemType)
+{
+    return uint16_t(1) << static_cast<uint16_t>(systemType);
+}
+
+static eosio::name getBadgeLink(SystemBadgeType systemType)
+{
+    switch (systemType)
+    {
+    case SystemBadgeType::Admin:
+        return hypha::common::ADMIN;
+    case SystemBadgeType::Enroller:
+        return hypha::common::ENROLLER;
+    case SystemBadgeType::Treasurer:
+        return treasury::common::links::TREASURER;
+    case SystemBadgeType::NorthStar:
+        return hypha::common::NORTH_STAR_HOLDER;
+    case SystemBadgeType::Voter:
+        return badges_links::VOTER;
+    case SystemBadgeType::Delegate:
+        return badges_links::DELEGATE;
+    case SystemBadgeType::HeadDelegate:
+        return badges_links::HEAD_DELEGATE;
+    case SystemBadgeType::ChiefDelegate:
+        return badges_links::CHIEF_DELEGATE;
+    default:
+        EOS_CHECK(false, to_str("Invalid System Badge Type:", static_cast<uint64_t>(systemType)));
+        return eosio::name();
+    }
+}
+
+static bool holdsSystemBadge(dao& dao, uint64_t daoID, uint64_t memberID, SystemBadgeType systemType)
 {
-    return Edge::exists(dao.get_self(), daoID, memberID, hypha::common::ADMIN);
+    dao::member_badges_table memberBadges(dao.get_self(), daoID);
+
+    if (auto it = memberBadges.find(memberID); it != memberBadges.end()) {
+        return it->mask & getBadgeBit(systemType);
+    }
+
+    dao::badge_index_dao_table indexedDaos(dao.get_self(), dao.get_self().value);
+
+    if (indexedDaos.find(daoID) != indexedDaos.end()) {
+        return false;
+    }
+
+    //Badges of DAOs that aren't indexed yet are only stored as edges
+    return Edge::exists(dao.get_self(), daoID, memberID, getBadgeLink(systemType));
 }
 
-static bool hasEnrollerBadge(dao& dao, uint64_t daoID, uint64_t memberID) 
+bool hasAdminBadge(dao& dao, uint64_t daoID, uint64_t memberID) 
 {
-    return Edge::exists(dao.get_self(), daoID, memberID, hypha::common::ENROLLER);
+    return holdsSystemBadge(dao, daoID, memberID, SystemBadgeType::Admin);
 }
 
-static bool hasTreasurerBadge(dao& dao, uint64_t daoID, uint64_t memberID) 
+bool hasEnrollerBadge(dao& dao, uint64_t daoID, uint64_t memberID) 
 {
-    return Edge::exists(dao.get_self(), daoID, memberID, treasury::common::links::TREASURER);
+    return holdsSystemBadge(dao, daoID, memberID, SystemBadgeType::Enroller);
 }
 
 bool hasNorthStarBadge(dao& dao, uint64_t daoID, uint64_t memberID)
 {
-    return Edge::exists(dao.get_self(), daoID, memberID, hypha::common::NORTH_STAR_HOLDER);
+    return holdsSystemBadge(dao, daoID, memberID, SystemBadgeType::NorthStar);
 }
 
 bool hasVoterBadge(dao& dao, uint64_t daoID, uint64_t memberID)
 {
-    return Edge::exists(dao.get_self(), daoID, memberID, badges_links::VOTER);
+    return holdsSystemBadge(dao, daoID, memberID, SystemBadgeType::Voter);
 }
 
 bool hasDelegateBadge(dao& dao, uint64_t daoID, uint64_t memberID)
 {
-    return Edge::exists(dao.get_self(), daoID, memberID, badges_links::DELEGATE);
+    return holdsSystemBadge(dao, daoID, memberID, SystemBadgeType::Delegate);
 }
 
 bool hasHeadDelegateBadge(dao& dao, uint64_t daoID, uint64_t memberID)
 {
-    return Edge::exists(dao.get_self(), daoID, memberID, badges_links::HEAD_DELEGATE);
+    return holdsSystemBadge(dao, daoID, memberID, SystemBadgeType::HeadDelegate);
 }
 
 bool hasChiefDelegateBadge(dao& dao, uint64_t daoID, uint64_t memberID)
 {
-    return Edge::exists(dao.get_self(), daoID, memberID, badges_links::CHIEF_DELEGATE);
+    return holdsSystemBadge(dao, daoID, memberID, SystemBadgeType::ChiefDelegate);
 }
 
 bool isSelfApproveBadge(SystemBadgeType systemType)
@@ -293,29 +347,126 @@ void checkHoldsBadge(dao& dao, Document& badge, uint64_t daoID, uint64_t memberI
 
     if (type == BadgeType::User) return;
 
-    using HasBadgeFunc = decltype(&hasTreasurerBadge);
-
-    std::map<SystemBadgeType, HasBadgeFunc> hasBadgeMap {
-      { SystemBadgeType::Admin, hasAdminBadge },
-      { SystemBadgeType::Enroller, hasEnrollerBadge },
-      { SystemBadgeType::Treasurer, hasTreasurerBadge },
-      { SystemBadgeType::NorthStar, hasNorthStarBadge },
-      { SystemBadgeType::Voter, hasVoterBadge },
-      { SystemBadgeType::Delegate, hasDelegateBadge },
-      { SystemBadgeType::HeadDelegate, hasHeadDelegateBadge },
-      { SystemBadgeType::ChiefDelegate, hasChiefDelegateBadge }
-    };
-
-    EOS_CHECK(
-        hasBadgeMap.count(systemType),
-        to_str("Invalid System Badge Type:", static_cast<uint64_t>(systemType))
-    )
-    
     //User should not have the given Badge
     EOS_CHECK(
-        !hasBadgeMap[systemType](dao, daoID, memberID),
+        !holdsSystemBadge(dao, daoID, memberID, systemType),
         "User already holds badge"
     );
 }
 
+//Mask of the system badges the member holds according to the badge edges
+static uint16_t getEdgesMask(dao& dao, uint64_t daoID, uint64_t memberID)
+{
+    auto systemTypes = std::array{
+        SystemBadgeType::Admin,
+        SystemBadgeType::Enroller,
+        SystemBadgeType::NorthStar,
+        SystemBadgeType::Voter,
+        SystemBadgeType::Delegate,
+        SystemBadgeType::HeadDelegate,
+        SystemBadgeType::ChiefDelegate
+    };
+
+    uint16_t mask = 0;
+
+    for (auto systemType : systemTypes) {
+        if (Edge::exists(dao.get_self(), daoID, memberID, getBadgeLink(systemType))) {
+            mask |= getBadgeBit(systemType);
+        }
+    }
+
+#ifdef USE_TREASURY
+    //Treasurers are linked from the treasury document instead of the DAO
+    if (auto [hasTreasury, treasuryEdge] = Edge::getIfExists(dao.get_self(), daoID, treasury::common::links::TREASURY);
+        hasTreasury && Edge::exists(dao.get_self(), treasuryEdge.getToNode(), memberID, treasury::common::links::TREASURER)) {
+        mask |= getBadgeBit(SystemBadgeType::Treasurer);
+    }
+#endif
+
+    return mask;
+}
+
+static void writeMask(dao& dao, dao::member_badges_table& memberBadges, dao::member_badges_table::const_iterator it, uint64_t memberID, uint16_t mask)
+{
+    if (it == memberBadges.end()) {
+        if (mask) {
+            memberBadges.emplace(dao.get_self(), [&](dao::MemberBadges& row) {
+                row.member_id = memberID;
+                row.mask = mask;
+            });
+        }
+    }
+    else if (mask == 0) {
+        memberBadges.erase(it);
+    }
+    else {
+        memberBadges.modify(it, dao.get_self(), [&](dao::MemberBadges& row) {
+            row.mask = mask;
+        });
+    }
+}
+
+void setSystemBadge(dao& dao, uint64_t daoID, uint64_t memberID, SystemBadgeType systemType, bool active)
+{
+    dao::member_badges_table memberBadges(dao.get_self(), daoID);
+
+    auto it = memberBadges.find(memberID);
+
+    uint16_t mask = 0;
+
+    if (it != memberBadges.end()) {
+        mask = it->mask;
+    }
+    else if (dao::badge_index_dao_table indexedDaos(dao.get_self(), dao.get_self().value); 
+             indexedDaos.find(daoID) == indexedDaos.end()) {
+        //The rest of the badges of DAOs that aren't indexed yet are only stored as edges
+        mask = getEdgesMask(dao, daoID, memberID);
+    }
+
+    mask = active ? (mask | getBadgeBit(systemType)) : (mask & ~getBadgeBit(systemType));
+
+    writeMask(dao, memberBadges, it, memberID, mask);
+}
+
+void initBadgeIndex(dao& dao, uint64_t daoID)
+{
+    dao::badge_index_dao_table indexedDaos(dao.get_self(), dao.get_self().value);
+
+    if (indexedDaos.find(daoID) == indexedDaos.end()) {
+        indexedDaos.emplace(dao.get_self(), [&](dao::BadgeIndexDao& row) {
+            row.dao_id = daoID;
+        });
+    }
+}
+
+std::optional<eosio::name> indexBadges(dao& dao, uint64_t daoID, const eosio::name& from, size_t maxMembers)
+{
+    //Badges are only assigned to members, so walking the DAO's membership rows
+    //keeps the backfill proportional to the DAO instead of the whole contract
+    dao::membership_stats_table stats(dao.get_self(), dao.get_self().value);
+    auto statsIt = stats.find(daoID);
+
+    EOS_CHECK(
+        statsIt != stats.end() && statsIt->indexed,
+        to_str("Members of the DAO have to be indexed before its badges: ", daoID)
+    );
+
+    dao::membership_table memberships(dao.get_self(), daoID);
+    dao::member_badges_table memberBadges(dao.get_self(), daoID);
+
+    auto it = memberships.lower_bound(from.value);
+
+    for (size_t i = 0; it != memberships.end() && i < maxMembers; ++it, ++i) {
+        writeMask(dao, memberBadges, memberBadges.find(it->member_id), it->member_id, getEdgesMask(dao, daoID, it->member_id));
+    }
+
+    if (it != memberships.end()) {
+        return it->account;
+    }
+
+    initBadgeIndex(dao, daoID);
+
+    return std::nullopt;
+}
+
 } // namespace hypha::badges
@@ -1,4 +1,5 @@
 #include <ballots/vote.hpp>
+#include <ballots/vote_tally.hpp>
 #include <dao.hpp>
 #include <common.hpp>
 #include <document_graph/edge.hpp>
@@ -17,12 +18,34 @@
 
 namespace hypha
 {
+    //Max number of vote rows erased on each step of a proposal cleanup
+    static constexpr size_t MAX_ROWS_PER_ACTION = 50;
+
     Vote::Vote(hypha::dao& dao, uint64_t id)
     : TypedDocument(dao, id, TYPED_DOCUMENT_TYPE)
     {
         TRACE_FUNCTION()
     }
 
+    static eosio::asset getVoiceBalance(dao& dao, const eosio::name& voter, const eosio::name& daoName, const eosio::asset& voiceToken)
+    {
+        // Todo: Need to ensure that the balance does not need a decay.
+        name hvoiceContract = dao.getContractName(GOVERNANCE_TOKEN_CONTRACT);
+        hypha::voice::accounts acnts(hvoiceContract, voter.value);
+        auto account_index = acnts.get_index<name("bykey")>();
+
+        auto v_itr = account_index.find(
+            voice::accountv2::build_key(
+                daoName,
+                voiceToken.symbol.code()
+            )
+        );
+
+        eosio::check(v_itr != account_index.end(), "No VOICE found");
+
+        return v_itr->balance;
+    }
+
     Vote::Vote(
         hypha::dao& dao,
         const eosio::name voter,
@@ -53,23 +76,21 @@ namespace hypha
 
         Document voterDoc(dao.get_self(), dao.getMemberID(voter));
 
-        std::vector<Edge> votes = dao.getGraph().getEdgesFrom(proposal.getID(), common::VOTE);
-        for (auto vote : votes) {
-            if (vote.getCreator() == voter) {
+        if (auto previousVoteID = findVote(dao, proposal.getID(), voterDoc.getID(), voter)) {
 
-                Document voteDocument(dao.get_self(), vote.getToNode());
+            Vote voteDocument(dao, *previousVoteID);
 
-                // Already voted, erase edges and allow to vote again.
-                Edge::get(dao.get_self(), voterDoc.getID(), voteDocument.getID(), common::VOTE).erase();
-                Edge::get(dao.get_self(), proposal.getID(), voteDocument.getID(), common::VOTE).erase();
-                Edge::get(dao.get_self(), voteDocument.getID(), voterDoc.getID(), common::OWNED_BY).erase();
-                Edge::get(dao.get_self(), voteDocument.getID(), proposal.getID(), common::VOTE_ON).erase();
+            //Keep track of the replaced vote so the tally can be updated with the delta
+            m_previousVote = std::make_pair(voteDocument.getVote(), voteDocument.getPower());
 
-                if (!dao.getGraph().hasEdges(voteDocument.getID())) {
-                    dao.getGraph().eraseDocument(voteDocument.getID(), false);
-                }
+            // Already voted, erase edges and allow to vote again.
+            Edge::get(dao.get_self(), voterDoc.getID(), voteDocument.getId(), common::VOTE).erase();
+            Edge::get(dao.get_self(), proposal.getID(), voteDocument.getId(), common::VOTE).erase();
+            Edge::get(dao.get_self(), voteDocument.getId(), voterDoc.getID(), common::OWNED_BY).erase();
+            Edge::get(dao.get_self(), voteDocument.getId(), proposal.getID(), common::VOTE_ON).erase();
 
-                break;
+            if (!dao.getGraph().hasEdges(voteDocument.getId())) {
+                dao.getGraph().eraseDocument(voteDocument.getId(), false);
             }
         }
         
@@ -77,30 +98,32 @@ namespace hypha
 
         Settings* daoSettings = dao.getSettingsDocument(daoHash);
 
-        asset voiceToken = daoSettings->getOrFail<asset>(common::VOICE_TOKEN);
+        asset voiceToken = daoSettings->getVoiceToken();
 
         //If community voting is active for this proposal, every vote is just 1
         if (auto [_, communityVote] = proposal.getContentWrapper().get(SYSTEM, common::COMMUNITY_VOTING);
             communityVote && communityVote->getAs<int64_t>()) {
-            votePower = denormalizeToken(1.0, voiceToken);
+            votePower = asset{ getTokenUnit(voiceToken), voiceToken.symbol };
         }
-        //Else fetch vote power from the voice contract
-        else {
-            // Todo: Need to ensure that the balance does not need a decay.
-            name hvoiceContract = dao.getSettingOrFail<eosio::name>(GOVERNANCE_TOKEN_CONTRACT);
-            hypha::voice::accounts acnts(hvoiceContract, voter.value);
-            auto account_index = acnts.get_index<name("bykey")>();
-
-            auto v_itr = account_index.find(
-                voice::accountv2::build_key(
-                    daoSettings->getOrFail<name>(DAO_NAME),
-                    voiceToken.symbol.code()
-                )
-            );
+        //Else use the power snapshotted at the first vote of the voter
+        else if (daoSettings->getSettingOrDefault<int64_t>(common::VOICE_SNAPSHOT, 0) == 1) {
+            dao::voter_power_table powers(dao.get_self(), proposal.getID());
 
-            eosio::check(v_itr != account_index.end(), "No VOICE found");
+            if (auto it = powers.find(voterDoc.getID()); it != powers.end()) {
+                votePower = it->power;
+            }
+            else {
+                votePower = getVoiceBalance(dao, voter, daoSettings->getDaoName(), voiceToken);
 
-            votePower = v_itr->balance;
+                powers.emplace(dao.get_self(), [&](dao::VoterPower& row) {
+                    row.voter_id = voterDoc.getID();
+                    row.power = votePower;
+                });
+            }
+        }
+        //Else fetch vote power from the voice contract
+        else {
+            votePower = getVoiceBalance(dao, voter, daoSettings->getDaoName(), voiceToken);
         }
 
         ContentGroups contentGroups{
@@ -130,18 +153,204 @@ namespace hypha
         // an edge from the vote to the proposal named voteon
         Edge::write(dao.get_self(), voter, getDocument().getID(), proposal.getID(), common::VOTE_ON);
 
+        setIndexedVote(dao, proposal.getID(), voterDoc.getID(), getDocument().getID());
+
         if (badges::hasNorthStarBadge(dao, daoHash, voterDoc.getID())) {
             if (vote == VOTE_FAIL){
                 Edge(dao.get_self(), dao.get_self(), voterDoc.getID(), proposal.getID(), common::VETO);
                 Edge(dao.get_self(), dao.get_self(), proposal.getID(), voterDoc.getID(), common::VETO_BY);
+                VoteTally::updateBallotVetoes(dao, proposal.getID(), 1);
             }
             else if (Edge::exists(dao.get_self(), voterDoc.getID(), proposal.getID(), common::VETO)) {
                 Edge::get(dao.get_self(), voterDoc.getID(), proposal.getID(), common::VETO).erase();
                 Edge::get(dao.get_self(), proposal.getID(), voterDoc.getID(), common::VETO_BY).erase();
+                VoteTally::updateBallotVetoes(dao, proposal.getID(), -1);
             }
         }
     }
 
+    void Vote::initIndex(dao& dao, uint64_t proposalID)
+    {
+        dao::vote_index_proposal_table indexed(dao.get_self(), dao.get_self().value);
+
+        if (indexed.find(proposalID) != indexed.end()) {
+            return;
+        }
+
+        indexed.emplace(dao.get_self(), [&](dao::VoteIndexProposal& row) {
+            row.proposal_id = proposalID;
+            row.voters = 0;
+            row.complete = true;
+        });
+    }
+
+    void Vote::indexVotes(dao& dao, uint64_t proposalID, const std::vector<uint64_t>& voteIDs)
+    {
+        TRACE_FUNCTION()
+
+        auto daoID = Edge::get(dao.get_self(), proposalID, common::DAO).getToNode();
+
+        EOS_CHECK(
+            Edge::exists(dao.get_self(), daoID, proposalID, common::PROPOSAL),
+            "Only votes of active proposals can be indexed"
+        );
+
+        for (auto voteID : voteIDs) {
+            EOS_CHECK(
+                Edge::exists(dao.get_self(), proposalID, voteID, common::VOTE),
+                to_str("Document ", voteID, " is not a vote on proposal ", proposalID)
+            );
+
+            Vote vote(dao, voteID);
+
+            setIndexedVote(dao, proposalID, dao.getMemberID(vote.getVoter()), voteID);
+        }
+
+        dao::vote_index_proposal_table indexed(dao.get_self(), dao.get_self().value);
+
+        auto it = indexed.find(proposalID);
+
+        if (it != indexed.end() && !it->complete && 
+            it->voters == Edge::getEdgesFromCount(dao.get_self(), proposalID, common::VOTE)) {
+            indexed.modify(it, dao.get_self(), [](dao::VoteIndexProposal& row) {
+                row.complete = true;
+            });
+        }
+    }
+
+    void Vote::eraseVotes(dao& dao, uint64_t proposalID)
+    {
+        TRACE_FUNCTION()
+
+        if (eraseIndex(dao, proposalID, MAX_ROWS_PER_ACTION) &&
+            erasePowers(dao, proposalID, MAX_ROWS_PER_ACTION)) {
+            return;
+        }
+
+        //Each page runs in its own transaction so closing doesn't depend on the number of voters
+        eosio::action act(
+            eosio::permission_level(dao.get_self(), eosio::name("active")),
+            dao.get_self(),
+            eosio::name("clearvotes"),
+            std::make_tuple(proposalID)
+        );
+
+        dao.schedule_deferred_action(eosio::time_point_sec(eosio::current_time_point()), act);
+    }
+
+    bool Vote::eraseIndex(dao& dao, uint64_t proposalID, size_t maxRows)
+    {
+        TRACE_FUNCTION()
+
+        dao::proposal_vote_table votes(dao.get_self(), dao.get_self().value);
+
+        auto byProposalVoter = votes.get_index<eosio::name("bypropvoter")>();
+
+        auto it = byProposalVoter.lower_bound(dao::ProposalVote::build_key(proposalID, 0));
+        auto end = byProposalVoter.lower_bound(dao::ProposalVote::build_key(proposalID + 1, 0));
+
+        for (size_t i = 0; it != end && i < maxRows; ++i) {
+            it = byProposalVoter.erase(it);
+        }
+
+        if (it != end) {
+            return false;
+        }
+
+        dao::vote_index_proposal_table indexed(dao.get_self(), dao.get_self().value);
+
+        if (auto indexIt = indexed.find(proposalID); indexIt != indexed.end()) {
+            indexed.erase(indexIt);
+        }
+
+        return true;
+    }
+
+    bool Vote::erasePowers(dao& dao, uint64_t proposalID, size_t maxRows)
+    {
+        TRACE_FUNCTION()
+
+        dao::voter_power_table powers(dao.get_self(), proposalID);
+
+        auto it = powers.begin();
+
+        for (size_t i = 0; it != powers.end() && i < maxRows; ++i) {
+            it = powers.erase(it);
+        }
+
+        return it == powers.end();
+    }
+
+    std::optional<uint64_t> Vote::findVote(dao& dao, uint64_t proposalID, uint64_t voterID, const eosio::name& voter)
+    {
+        TRACE_FUNCTION()
+
+        dao::proposal_vote_table votes(dao.get_self(), dao.get_self().value);
+
+        auto byProposalVoter = votes.get_index<eosio::name("bypropvoter")>();
+
+        if (auto it = byProposalVoter.find(dao::ProposalVote::build_key(proposalID, voterID));
+            it != byProposalVoter.end()) {
+            return it->vote_id;
+        }
+
+        dao::vote_index_proposal_table indexed(dao.get_self(), dao.get_self().value);
+
+        if (auto it = indexed.find(proposalID); it != indexed.end() && it->complete) {
+            return std::nullopt;
+        }
+
+        //Proposals with votes cast before the votes index existed
+        std::vector<Edge> votes = dao.getGraph().getEdgesFrom(proposalID, common::VOTE);
+        for (auto& vote : votes) {
+            if (vote.getCreator() == voter) {
+                return vote.getToNode();
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    void Vote::setIndexedVote(dao& dao, uint64_t proposalID, uint64_t voterID, uint64_t voteID)
+    {
+        dao::proposal_vote_table votes(dao.get_self(), dao.get_self().value);
+
+        auto byProposalVoter = votes.get_index<eosio::name("bypropvoter")>();
+
+        if (auto it = byProposalVoter.find(dao::ProposalVote::build_key(proposalID, voterID));
+            it != byProposalVoter.end()) {
+            if (it->vote_id != voteID) {
+                byProposalVoter.modify(it, dao.get_self(), [&](dao::ProposalVote& row) {
+                    row.vote_id = voteID;
+                });
+            }
+
+            return;
+        }
+
+        votes.emplace(dao.get_self(), [&](dao::ProposalVote& row) {
+            row.id = votes.available_primary_key();
+            row.proposal_id = proposalID;
+            row.voter_id = voterID;
+            row.vote_id = voteID;
+        });
+
+        dao::vote_index_proposal_table indexed(dao.get_self(), dao.get_self().value);
+
+        if (auto it = indexed.find(proposalID); it != indexed.end()) {
+            indexed.modify(it, dao.get_self(), [](dao::VoteIndexProposal& row) {
+                row.voters += 1;
+            });
+        }
+        else {
+            indexed.emplace(dao.get_self(), [&](dao::VoteIndexProposal& row) {
+                row.proposal_id = proposalID;
+                row.voters = 1;
+                row.complete = false;
+            });
+        }
+    }
+
     const std::string& Vote::getVote()
     {
         TRACE_FUNCTION()
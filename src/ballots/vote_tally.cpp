@@ -10,6 +10,20 @@
 
 namespace hypha
 {
+    static eosio::asset* getBallotSum(dao::ProposalBallot& ballot, const std::string& option)
+    {
+        if (option == common::BALLOT_DEFAULT_OPTION_PASS.to_string()) {
+            return &ballot.pass;
+        }
+        else if (option == common::BALLOT_DEFAULT_OPTION_ABSTAIN.to_string()) {
+            return &ballot.abstain;
+        }
+        else if (option == common::BALLOT_DEFAULT_OPTION_FAIL.to_string()) {
+            return &ballot.fail;
+        }
+
+        return nullptr;
+    }
 
     VoteTally::VoteTally(dao& dao, uint64_t id)
     : TypedDocument(dao, id, TYPED_DOCUMENT_TYPE)
@@ -38,7 +52,7 @@ namespace hypha
 
         ContentGroup* contentOptions = proposal.getContentWrapper().getGroupOrFail(BALLOT_OPTIONS);
 
-        auto voiceToken = daoSettings->getOrFail<eosio::asset>(common::VOICE_TOKEN);
+        auto voiceToken = daoSettings->getVoiceToken();
 
         std::map<std::string, eosio::asset> optionsTally;
         std::vector<std::string> optionsTallyOrdered;
@@ -69,9 +83,125 @@ namespace hypha
 
         initializeDocument(dao, tallyContentGroups);
 
+        //Keep the ballot row in sync with the rebuilt tally
+        dao::ballot_table ballots(dao.get_self(), dao.get_self().value);
+
+        if (auto it = ballots.find(proposal.getID()); it != ballots.end()) {
+            ballots.modify(it, dao.get_self(), [&](dao::ProposalBallot& ballot) {
+                for (auto& [option, power] : optionsTally) {
+                    if (auto sum = getBallotSum(ballot, option)) {
+                        *sum = power;
+                    }
+                }
+            });
+        }
+
         Edge::write(dao.get_self(), dao.get_self(), proposal.getID(), getDocument().getID(), common::VOTE_TALLY);
     }
 
+    void VoteTally::updateVote(
+        const std::optional<std::pair<std::string, eosio::asset>>& previousVote,
+        const std::string& option,
+        const eosio::asset& power
+    )
+    {
+        TRACE_FUNCTION()
+        auto cw = getDocument().getContentWrapper();
+
+        if (previousVote) {
+            auto& [prevOption, prevPower] = *previousVote;
+
+            auto& prevTally = cw.getOrFail(
+                prevOption,
+                VOTE_POWER,
+                to_str("Vote tally is missing option: ", prevOption)
+            )->getAs<eosio::asset>();
+
+            EOS_CHECK(
+                prevTally >= prevPower,
+                to_str("Vote tally is inconsistent for option: ", prevOption, ", rebuild it with rebuildtally")
+            );
+
+            prevTally -= prevPower;
+        }
+
+        auto& optionTally = cw.getOrFail(
+            option,
+            VOTE_POWER,
+            to_str("Vote tally is missing option: ", option)
+        )->getAs<eosio::asset>();
+
+        optionTally += power;
+
+        update();
+    }
+
+    void VoteTally::initBallot(dao& dao, uint64_t proposalID, const eosio::asset& supply)
+    {
+        dao::ballot_table ballots(dao.get_self(), dao.get_self().value);
+
+        const asset zero(0, supply.symbol);
+
+        ballots.emplace(dao.get_self(), [&](dao::ProposalBallot& ballot) {
+            ballot.proposal_id = proposalID;
+            ballot.pass = zero;
+            ballot.abstain = zero;
+            ballot.fail = zero;
+            ballot.vetoes = 0;
+            ballot.supply = supply;
+        });
+    }
+
+    void VoteTally::updateBallot(
+        dao& dao,
+        uint64_t proposalID,
+        const std::optional<std::pair<std::string, eosio::asset>>& previousVote,
+        const std::string& option,
+        const eosio::asset& power
+    )
+    {
+        dao::ballot_table ballots(dao.get_self(), dao.get_self().value);
+
+        auto it = ballots.find(proposalID);
+
+        //Proposals published before the ballots table existed
+        if (it == ballots.end()) {
+            return;
+        }
+
+        ballots.modify(it, dao.get_self(), [&](dao::ProposalBallot& ballot) {
+            if (previousVote) {
+                if (auto sum = getBallotSum(ballot, previousVote->first)) {
+                    *sum -= previousVote->second;
+                }
+            }
+
+            if (auto sum = getBallotSum(ballot, option)) {
+                *sum += power;
+            }
+        });
+    }
+
+    void VoteTally::updateBallotVetoes(dao& dao, uint64_t proposalID, int32_t delta)
+    {
+        dao::ballot_table ballots(dao.get_self(), dao.get_self().value);
+
+        if (auto it = ballots.find(proposalID); it != ballots.end()) {
+            ballots.modify(it, dao.get_self(), [&](dao::ProposalBallot& ballot) {
+                ballot.vetoes += delta;
+            });
+        }
+    }
+
+    void VoteTally::eraseBallot(dao& dao, uint64_t proposalID)
+    {
+        dao::ballot_table ballots(dao.get_self(), dao.get_self().value);
+
+        if (auto it = ballots.find(proposalID); it != ballots.end()) {
+            ballots.erase(it);
+        }
+    }
+
     const std::string VoteTally::buildNodeLabel(ContentGroups &content)
     {
         return "VoteTally";
@@ -96,6 +96,23 @@ namespace hypha
         return content_wrapper.getOrFail(GROUP_COMMENT, ENTRY_AUTHOR)->getAs<eosio::name>();
     }
 
+    uint64_t Comment::getSectionId()
+    {
+        TRACE_FUNCTION()
+        uint64_t parentId = Edge::get(getDao().get_self(), getId(), common::COMMENT_OF).getToNode();
+
+        while (true) {
+            Document parent(getDao().get_self(), parentId);
+            auto type = parent.getContentWrapper().getOrFail(SYSTEM, TYPE)->getAs<eosio::name>();
+
+            if (type == eosio::name(document_types::COMMENT_SECTION)) {
+                return parentId;
+            }
+
+            parentId = Edge::get(getDao().get_self(), parentId, common::COMMENT_OF).getToNode();
+        }
+    }
+
     void Comment::edit(const string& new_content)
     {
         TRACE_FUNCTION()
@@ -120,18 +137,4 @@ namespace hypha
         content_wrapper.insertOrReplace(*group, Content(ENTRY_DELETED, true));
         this->update();
     }
-
-    void Comment::remove()
-    {
-        TRACE_FUNCTION()
-
-        // only comments should be here
-        std::vector<Edge> commentsOf = this->getDao().getGraph().getEdgesFrom(getId(), common::COMMENT);
-        for (auto& edge : commentsOf) {
-            Comment(this->getDao(), edge.getToNode()).remove();
-        }
-
-        this->getDao().getGraph().removeEdges(getId());
-        this->erase();
-    }
 }
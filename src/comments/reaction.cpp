@@ -80,11 +80,30 @@ namespace hypha
     {
         uint64_t memberId = getDao().getMemberID(who);
         uint64_t likeableId = getLikeableId();
+
+        dao::member_reaction_table reactions(getDao().get_self(), getDao().get_self().value);
+
+        auto byLikeableMember = reactions.get_index<eosio::name("bylikemember")>();
+
         EOS_CHECK(
+            byLikeableMember.find(dao::MemberReaction::build_key(likeableId, memberId)) == byLikeableMember.end() &&
+            //Reactions made before the reactions table existed only have edges
             !Edge::exists(getDao().get_self(), memberId, likeableId, common::REACTED_TO),
             "Member already reacted to this document"
         );
 
+        auto type = getType();
+
+        reactions.emplace(getDao().get_self(), [&](dao::MemberReaction& row) {
+            row.id = reactions.available_primary_key();
+            row.likeable_id = likeableId;
+            row.member_id = memberId;
+            row.reaction_id = getId();
+            row.type = type;
+        });
+
+        updateCount(likeableId, 1);
+
         // Member reacted to content
         Edge::getOrNew(getDao().get_self(), who, memberId, likeableId, common::REACTED_TO);
         // Content has been reacted by member
@@ -104,6 +123,17 @@ namespace hypha
             "Member has not reacted to this document"
         );
 
+        dao::member_reaction_table reactions(getDao().get_self(), getDao().get_self().value);
+
+        auto byLikeableMember = reactions.get_index<eosio::name("bylikemember")>();
+
+        if (auto it = byLikeableMember.find(dao::MemberReaction::build_key(likeableId, memberId)); 
+            it != byLikeableMember.end()) {
+            byLikeableMember.erase(it);
+        }
+
+        updateCount(likeableId, -1);
+
         Edge::get(getDao().get_self(), memberId, likeableId, common::REACTED_TO).erase();
         Edge::get(getDao().get_self(), likeableId, memberId, common::REACTED_BY).erase();
         Edge::get(getDao().get_self(), memberId, this->getId(), common::REACTION_LINK).erase();
@@ -123,6 +153,16 @@ namespace hypha
     Reaction Reaction::getReactionByUser(dao& dao, Likeable& likeable, const eosio::name who)
     {
         uint64_t memberId = dao.getMemberID(who);
+
+        dao::member_reaction_table reactions(dao.get_self(), dao.get_self().value);
+
+        auto byLikeableMember = reactions.get_index<eosio::name("bylikemember")>();
+
+        if (auto it = byLikeableMember.find(dao::MemberReaction::build_key(likeable.getId(), memberId)); 
+            it != byLikeableMember.end()) {
+            return Reaction(dao, it->reaction_id);
+        }
+
         Edge::get(dao.get_self(), memberId, likeable.getId(), common::REACTED_TO);
 
         std::vector<Edge> reactionEdges = dao.getGraph().getEdgesFromOrFail(likeable.getId(), common::REACTION);
@@ -153,4 +193,65 @@ namespace hypha
     {
         return Edge::get(getDao().get_self(), this->getId(), common::REACTION_OF).getToNode();
     }
+
+    eosio::name Reaction::getType()
+    {
+        return getDocument().getContentWrapper().getOrFail(
+            CONTENT_GROUP_LABEL_REACTION,
+            CONTENT_REACTION_TYPE,
+            "Could not find reaction_type, this is a bug."
+        )->getAs<eosio::name>();
+    }
+
+    void Reaction::updateCount(uint64_t likeableId, int64_t delta)
+    {
+        dao::reaction_count_table counts(getDao().get_self(), likeableId);
+
+        auto type = getType();
+
+        auto it = counts.find(type.value);
+
+        if (it == counts.end()) {
+            //First time the counter is used, start from the members linked to the reactions
+            //of this type made before it existed.
+            //Edges of the reaction being added or removed are not updated yet
+            uint64_t count = 0;
+
+            for (auto& edge : getDao().getGraph().getEdgesFrom(likeableId, common::REACTION)) {
+                if (Reaction(getDao(), edge.getToNode()).getType() == type) {
+                    count += Edge::getEdgesFromCount(getDao().get_self(), edge.getToNode(), common::REACTION_LINK_REVERSE);
+                }
+            }
+
+            counts.emplace(getDao().get_self(), [&](dao::ReactionCount& row) {
+                row.type = type;
+                row.count = delta < 0 ? count - 1 : count + 1;
+            });
+        }
+        else {
+            counts.modify(it, getDao().get_self(), [&](dao::ReactionCount& row) {
+                row.count += delta;
+            });
+        }
+    }
+
+    void Reaction::eraseReactions(dao& dao, uint64_t likeableId)
+    {
+        dao::member_reaction_table reactions(dao.get_self(), dao.get_self().value);
+
+        auto byLikeableMember = reactions.get_index<eosio::name("bylikemember")>();
+
+        auto it = byLikeableMember.lower_bound(dao::MemberReaction::build_key(likeableId, 0));
+        auto end = byLikeableMember.lower_bound(dao::MemberReaction::build_key(likeableId + 1, 0));
+
+        while (it != end) {
+            it = byLikeableMember.erase(it);
+        }
+
+        dao::reaction_count_table counts(dao.get_self(), likeableId);
+
+        for (auto countIt = counts.begin(); countIt != counts.end();) {
+            countIt = counts.erase(countIt);
+        }
+    }
 }
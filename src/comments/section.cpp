@@ -1,5 +1,6 @@
 #include <comments/section.hpp>
 #include <comments/comment.hpp>
+#include <comments/reaction.hpp>
 #include <common.hpp>
 #include <document_graph/edge.hpp>
 #include <dao.hpp>
@@ -10,6 +11,10 @@ namespace hypha
 {
 
     const std::string GROUP_SECTION = "comment_section";
+    const std::string ENTRY_PENDING_DELETION = "pending_deletion";
+
+    //Max number of comments removed on each step of a section removal
+    static constexpr size_t MAX_NODES_PER_ACTION = 50;
 
     Section::Section(dao& dao, uint64_t id) : Likeable(dao, id, TYPED_DOCUMENT_TYPE)
     {
@@ -55,12 +60,80 @@ namespace hypha
     {
         TRACE_FUNCTION()
 
-        std::vector<Edge> comments = this->getDao().getGraph().getEdgesFrom(getId(), common::COMMENT);
-        for (auto& edge : comments) {
-            Comment(this->getDao(), edge.getToNode()).remove();
+        auto contentWrapper = getDocument().getContentWrapper();
+        auto group = contentWrapper.getGroupOrFail(GROUP_SECTION);
+
+        //New comments can't be added while the section is being removed
+        contentWrapper.insertOrReplace(*group, Content(ENTRY_PENDING_DELETION, int64_t(1)));
+        update();
+
+        dao::section_removal_table removals(getDao().get_self(), getDao().get_self().value);
+
+        EOS_CHECK(
+            removals.find(getId()) == removals.end(),
+            "Comment section is already being removed"
+        );
+
+        removals.emplace(getDao().get_self(), [&](dao::SectionRemoval& removal) {
+            removal.section_id = getId();
+            removal.stack = { getId() };
+        });
+
+        removeNodes(getDao(), getId());
+    }
+
+    void Section::removeNodes(dao& dao, uint64_t sectionID)
+    {
+        TRACE_FUNCTION()
+
+        dao::section_removal_table removals(dao.get_self(), dao.get_self().value);
+
+        auto removalIt = removals.find(sectionID);
+
+        EOS_CHECK(
+            removalIt != removals.end(),
+            to_str("Comment section is not being removed: ", sectionID)
+        );
+
+        auto stack = removalIt->stack;
+
+        //Each node is pushed once and removed once
+        for (size_t steps = 0; !stack.empty() && steps < MAX_NODES_PER_ACTION * 2; ++steps) {
+            auto nodeID = stack.back();
+
+            if (auto [hasReplies, reply] = Edge::getIfExists(dao.get_self(), nodeID, common::COMMENT); 
+                hasReplies) {
+                stack.push_back(reply.getToNode());
+            }
+            else {
+                Reaction::eraseReactions(dao, nodeID);
+                dao.getGraph().eraseDocument(nodeID, true);
+                stack.pop_back();
+            }
+        }
+
+        if (stack.empty()) {
+            removals.erase(removalIt);
+            return;
         }
 
-        this->getDao().getGraph().removeEdges(getId());
-        this->erase();
+        removals.modify(removalIt, dao.get_self(), [&](dao::SectionRemoval& removal) {
+            removal.stack = std::move(stack);
+        });
+
+        eosio::action act(
+            eosio::permission_level(dao.get_self(), eosio::name("active")),
+            dao.get_self(),
+            eosio::name("cmntsecrem"),
+            std::make_tuple(sectionID)
+        );
+
+        dao.schedule_deferred_action(eosio::time_point_sec(eosio::current_time_point()), act);
+    }
+
+    bool Section::isPendingDeletion()
+    {
+        auto [_, pending] = getDocument().getContentWrapper().get(GROUP_SECTION, ENTRY_PENDING_DELETION);
+        return pending && pending->getAs<int64_t>() == 1;
     }
 }
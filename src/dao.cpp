@@ -22,7 +22,10 @@
 #include <time_share.hpp>
 #include <settings.hpp>
 #include <treasury/treasury.hpp>
+#include <treasury/common.hpp>
 #include <typed_document.hpp>
+#include <ballots/vote.hpp>
+#include <ballots/vote_tally.hpp>
 #include <comments/section.hpp>
 #include <comments/comment.hpp>
 
@@ -90,7 +93,7 @@ void dao::cleandao(uint64_t dao_id)
     by_id.erase(idIt);
   }
 
-  auto voiceContract = getSettingOrFail<eosio::name>(GOVERNANCE_TOKEN_CONTRACT);
+  auto voiceContract = getContractName(GOVERNANCE_TOKEN_CONTRACT);
 
   //delete voice token, reward and peg tokens are not deletable ATM
   eosio::action(
@@ -106,6 +109,11 @@ void dao::remdoc(uint64_t doc_id)
     eosio::require_auth(get_self());
     Document doc(get_self(), doc_id);
     m_documentGraph.eraseDocument(doc_id, true);
+
+    Assignment::eraseClaimCursor(*this, doc_id);
+    TimeShare::eraseTimeline(get_self(), doc_id);
+    Vote::eraseVotes(*this, doc_id);
+    VoteTally::eraseBallot(*this, doc_id);
 }
 
 #ifdef DEVELOP_BUILD_HELPERS
@@ -247,13 +255,11 @@ static void updateCommunityMembership(dao& dao, const name& account, const asset
 
   dao.verifyDaoType(daoId);
 
-  auto settings = dao.getSettingsDocument();
-
-  auto rewardContract = settings->getOrFail<name>(REWARD_TOKEN_CONTRACT);
+  auto rewardContract = dao.getContractName(REWARD_TOKEN_CONTRACT);
 
   auto balance = getAccountBalance(rewardContract, account, token);
 
-  const auto minAmount = denormalizeToken(1.f, token);
+  const auto minAmount = asset{ getTokenUnit(token), token.symbol };
 
   auto member = dao.getOrCreateMember(account);
 
@@ -265,11 +271,13 @@ static void updateCommunityMembership(dao& dao, const name& account, const asset
         !Member::isCommunityMember(dao, daoId, account)) {
       //Create Community Membership
       Edge(dao.get_self(), dao.get_self(), daoId, member.getID(), common::COMMEMBER);
+      Member::setMembership(dao, daoId, account, membership::COMMUNITY, true);
     }
   }
   else if (Member::isCommunityMember(dao, daoId, account)) {
     //Remove membership if we no longer meet the requirements
     Edge::get(dao.get_self(), daoId, member.getID(), common::COMMEMBER).erase();
+    Member::setMembership(dao, daoId, account, membership::COMMUNITY, false);
   }
 }
 
@@ -445,6 +453,7 @@ void dao::remmember(uint64_t dao_id, const std::vector<name>& member_names)
     auto memberID = getMemberID(member);
     Edge::get(get_self(), dao_id, memberID, common::MEMBER).erase();
     Edge::get(get_self(), memberID, dao_id, common::MEMBER_OF).erase();
+    Member::setMembership(*this, dao_id, member, membership::CORE, false);
   }
 }
 
@@ -460,6 +469,7 @@ void dao::remapplicant(uint64_t dao_id, const std::vector<name>& applicant_names
     auto applicantID = getMemberID(applicant);
     Edge::get(get_self(), dao_id, applicantID, common::APPLICANT).erase();
     Edge::get(get_self(), applicantID, dao_id, common::APPLICANT_OF).erase();
+    Member::setMembership(*this, dao_id, applicant, membership::APPLICANT, false);
   }
 }
 
@@ -493,6 +503,15 @@ void dao::vote(const name& voter, uint64_t proposal_id, string& vote, const std:
   proposal->vote(voter, vote, docprop, notes);
 }
 
+void dao::indexvotes(uint64_t proposal_id, std::vector<uint64_t> vote_ids)
+{
+  TRACE_FUNCTION();
+
+  eosio::require_auth(get_self());
+
+  Vote::indexVotes(*this, proposal_id, vote_ids);
+}
+
 void dao::closedocprop(uint64_t proposal_id)
 {
   TRACE_FUNCTION();
@@ -508,6 +527,24 @@ void dao::closedocprop(uint64_t proposal_id)
   proposal->close(docprop);
 }
 
+void dao::rebuildtally(uint64_t proposal_id)
+{
+  TRACE_FUNCTION();
+  eosio::require_auth(get_self());
+
+  Document docprop(get_self(), proposal_id);
+
+  auto daoID = Edge::get(get_self(), docprop.getID(), common::DAO).getToNode();
+
+  EOS_CHECK(
+    Edge::exists(get_self(), daoID, docprop.getID(), common::PROPOSAL),
+    "Only the tally of published proposals can be rebuilt"
+  );
+
+  //Re-sums every vote of the proposal replacing the current tally
+  VoteTally(*this, docprop, getSettingsDocument(daoID));
+}
+
 void dao::delasset(uint64_t asset_id)
 {
   auto doc = Document(get_self(), asset_id);
@@ -585,6 +622,7 @@ void dao::cmntadd(const name& author, const string content, const uint64_t comme
   eosio::name type = commentOrSection.getContentWrapper().getOrFail(SYSTEM, TYPE)->template getAs<eosio::name>();
   if (type == eosio::name(document_types::COMMENT)) {
     Comment parent(*this, comment_or_section_id);
+    EOS_CHECK(!Section(*this, parent.getSectionId()).isPendingDeletion(), "Comment section is being removed");
     Comment(
       *this,
       parent,
@@ -594,6 +632,7 @@ void dao::cmntadd(const name& author, const string content, const uint64_t comme
   }
   else if (type == eosio::name(document_types::COMMENT_SECTION)) {
     Section parent(*this, comment_or_section_id);
+    EOS_CHECK(!parent.isPendingDeletion(), "Comment section is being removed");
     Comment(
       *this,
       parent,
@@ -628,6 +667,14 @@ void dao::cmntrem(const uint64_t comment_id)
   comment.markAsDeleted();
 }
 
+void dao::cmntsecrem(uint64_t section_id)
+{
+  TRACE_FUNCTION();
+  eosio::require_auth(get_self());
+
+  Section::removeNodes(*this, section_id);
+}
+
 void dao::reactadd(const name &user, const name &reaction, const uint64_t document_id)
 {
   TRACE_FUNCTION()
@@ -721,6 +768,8 @@ void dao::withdraw(name owner, uint64_t document_id)
   ContentWrapper::insertOrReplace(*detailsGroup, Content{ common::STATE, common::STATE_WITHDRAWED });
 
   assignment.update();
+
+  Assignment::eraseClaimCursor(*this, assignment.getID());
 }
 
 void dao::suspend(name proposer, uint64_t document_id, string reason)
@@ -753,6 +802,24 @@ void dao::suspend(name proposer, uint64_t document_id, string reason)
 }
 
 void dao::claimnextper(uint64_t assignment_id)
+{
+  TRACE_FUNCTION();
+  claimPeriods(assignment_id, 1);
+}
+
+void dao::claimperiods(uint64_t assignment_id, int64_t max_periods)
+{
+  TRACE_FUNCTION();
+
+  EOS_CHECK(
+    max_periods > 0,
+    "max_periods must be greater than 0"
+  );
+
+  claimPeriods(assignment_id, max_periods);
+}
+
+void dao::claimPeriods(uint64_t assignmentID, int64_t maxPeriods)
 {
   TRACE_FUNCTION();
 
@@ -761,7 +828,7 @@ void dao::claimnextper(uint64_t assignment_id)
     "Contract is paused for maintenance. Please try again later."
   );
 
-  Assignment assignment(this, assignment_id);
+  Assignment assignment(this, assignmentID);
 
   eosio::name assignee = assignment.getAssignee().getAccount();
 
@@ -796,22 +863,11 @@ void dao::claimnextper(uint64_t assignment_id)
   );
 
   std::optional<Period> periodToClaim = assignment.getNextClaimablePeriod();
-  EOS_CHECK(periodToClaim != std::nullopt, to_str("All available periods for this assignment have been claimed: ", assignment_id));
+  EOS_CHECK(periodToClaim != std::nullopt, to_str("All available periods for this assignment have been claimed: ", assignmentID));
 
   // require_auth(assignee);
   EOS_CHECK(has_auth(assignee) || has_auth(get_self()), "only assignee or " + get_self().to_string() + " can claim pay");
 
-  // Valid claim identified - start process
-  // process this claim
-  Edge::write(get_self(), get_self(), assignment.getID(), periodToClaim.value().getID(), common::CLAIMED);
-  int64_t periodStartSec = periodToClaim.value().getStartTime().sec_since_epoch();
-  int64_t periodEndSec = periodToClaim.value().getEndTime().sec_since_epoch();
-
-  // Pro-rate the payment if the assignment was created during the period being claimed
-  //float first_phase_ratio_calc = 1.f; // pro-rate based on elapsed % of the first phase
-
-  //EOS_CHECK(first_phase_ratio_calc <= 1, "fatal error: first_phase_ratio_calc is greater than 1: " + std::to_string(first_phase_ratio_calc));
-
   auto daoSettings = getSettingsDocument(daoID);
 
   EOS_CHECK(
@@ -823,44 +879,64 @@ void dao::claimnextper(uint64_t assignment_id)
   )
 
   auto daoTokens = AssetBatch{
-    .reward = daoSettings->getSettingOrDefault<asset>(common::REWARD_TOKEN),
-    .peg = daoSettings->getSettingOrDefault<asset>(common::PEG_TOKEN),
-    .voice = daoSettings->getOrFail<asset>(common::VOICE_TOKEN)
+    .reward = daoSettings->getRewardToken(),
+    .peg = daoSettings->getPegToken(),
+    .voice = daoSettings->getVoiceToken()
   };
 
   auto salary  = assignment.getSalary();
 
-  const asset& pegSalary = salary.peg;
-  const asset& voiceSalary = salary.voice;
-  const asset& rewardSalary = salary.reward;
-
   const int64_t initTimeShare = assignment.getInitialTimeShare()
     .getContentWrapper()
     .getOrFail(DETAILS, TIME_SHARE)
     ->getAs<int64_t>();
 
-  TimeShare current = assignment.getCurrentTimeShare();
+  TimeShare::initTimeline(get_self(), assignment.getID());
 
-  //Initialize nextOpt with current in order to have a valid initial timeShare
-  auto nextOpt = std::optional<TimeShare>{ current };
+  const uint64_t currentTimeShare = Edge::get(get_self(), assignment.getID(), common::CURRENT_TIME_SHARE).getToNode();
 
-  std::optional<TimeShare> lastUsedTimeShare = current;
+  uint64_t lastUsedTimeShare = currentTimeShare;
 
-  auto ab = calculatePeriodPayout(
+  AssetBatch total {
+    .reward = eosio::asset{ 0, daoTokens.reward.symbol },
+    .peg = eosio::asset{ 0, daoTokens.peg.symbol },
+    .voice = eosio::asset{ 0, daoTokens.voice.symbol }
+  };
+
+  Period firstPeriod = *periodToClaim;
+  Period lastPeriod = *periodToClaim;
+  int64_t claimedCount = 0;
+
+  // Valid claim identified - start process
+  // process each claim, each period only reads the timeline rows that overlap it
+  while (periodToClaim) {
+
+    assignment.setClaimed(*periodToClaim);
+
+    lastPeriod = *periodToClaim;
+
+    total += calculatePeriodPayout(
       *periodToClaim, 
-      AssetBatch{ .reward = rewardSalary, .peg = pegSalary, .voice = voiceSalary }, 
+      salary, 
       daoTokens, 
-      nextOpt,
-      lastUsedTimeShare, 
-      initTimeShare
-  );
+      assignment.getID(),
+      initTimeShare,
+      lastUsedTimeShare
+    );
+
+    if (++claimedCount >= maxPeriods) {
+      break;
+    }
+
+    periodToClaim = assignment.getNextClaimablePeriod();
+  }
 
   //If the last used time share is different from current time share
   //let's update the edge
-  if (lastUsedTimeShare->getID() != current.getID())
+  if (lastUsedTimeShare != currentTimeShare)
   {
     Edge::get(get_self(), assignment.getID(), common::CURRENT_TIME_SHARE).erase();
-    Edge::write(get_self(), get_self(), assignment.getID(), lastUsedTimeShare->getID(), common::CURRENT_TIME_SHARE);
+    Edge::write(get_self(), get_self(), assignment.getID(), lastUsedTimeShare, common::CURRENT_TIME_SHARE);
   }
 
   // EOS_CHECK(deferredSeeds.is_valid(), "fatal error: SEEDS has to be a valid asset");
@@ -877,20 +953,32 @@ void dao::claimnextper(uint64_t assignment_id)
     assignmentNodeLabel = to_str(assignment.getID());
   }
 
-  string memo = assignmentNodeLabel + ", period: " + periodToClaim.value().getNodeLabel();
+  string memo;
+
+  //Single period payments are linked to the claimed period,
+  //merged payments of several periods are linked to the assignment
+  uint64_t paymentFrom;
+
+  if (claimedCount == 1) {
+    memo = assignmentNodeLabel + ", period: " + firstPeriod.getNodeLabel();
+    paymentFrom = firstPeriod.getID();
+  }
+  else {
+    memo = to_str(assignmentNodeLabel, ", periods: ", firstPeriod.getNodeLabel(), " - ", lastPeriod.getNodeLabel());
+    paymentFrom = assignment.getID();
+  }
 
   if (daoTokens.reward.is_valid()) {
-    EOS_CHECK(ab.reward.is_valid(), "fatal error: REWARD has to be a valid asset");
-    makePayment(daoSettings, periodToClaim.value().getID(), assignee, ab.reward, memo, eosio::name{ 0 }, daoTokens);
+    EOS_CHECK(total.reward.is_valid(), "fatal error: REWARD has to be a valid asset");
   }
 
   if (daoTokens.peg.is_valid()) {
-    EOS_CHECK(ab.peg.is_valid(), "fatal error: PEG has to be a valid asset");
-    makePayment(daoSettings, periodToClaim.value().getID(), assignee, ab.peg, memo, eosio::name{ 0 }, daoTokens);
+    EOS_CHECK(total.peg.is_valid(), "fatal error: PEG has to be a valid asset");
   }
 
-  EOS_CHECK(ab.voice.is_valid(), "fatal error: VOICE has to be a valid asset");
-  makePayment(daoSettings, periodToClaim.value().getID(), assignee, ab.voice, memo, eosio::name{ 0 }, daoTokens);
+  EOS_CHECK(total.voice.is_valid(), "fatal error: VOICE has to be a valid asset");
+
+  makePayments(daoSettings, paymentFrom, assignee, total, memo, eosio::name{ 0 }, daoTokens, firstPeriod.getID(), lastPeriod.getID(), assignment.getID());
 }
 
 // void dao::simclaimall(name account, uint64_t dao_id, bool only_ids)
@@ -987,77 +1075,60 @@ void dao::claimnextper(uint64_t assignment_id)
 AssetBatch dao::calculatePeriodPayout(Period& period,
                                       const AssetBatch& salary,
                                       const AssetBatch& daoTokens,
-                                      std::optional<TimeShare>& nextTimeShareOpt,
-                                      std::optional<TimeShare>& lastUsedTimeShare,
-                                      int64_t initTimeShare)
+                                      uint64_t assignmentID,
+                                      int64_t initTimeShare,
+                                      uint64_t& lastUsedTimeShare)
 {
-  int64_t periodStartSec = period.getStartTime().sec_since_epoch();
-  int64_t periodEndSec = period.getEndTime().sec_since_epoch();
+  const int64_t periodStartSec = period.getStartTime().sec_since_epoch();
+  const int64_t periodEndSec = period.getEndTime().sec_since_epoch();
+  const int64_t fullPeriodSec = periodEndSec - periodStartSec;
 
   AssetBatch payout {
     .reward = eosio::asset{ 0, daoTokens.reward.symbol },
     .peg = eosio::asset{ 0, daoTokens.peg.symbol },
     .voice = eosio::asset{ 0, daoTokens.voice.symbol }
   };
-          
-  while (nextTimeShareOpt)
-  {
-    ContentWrapper nextWrapper = nextTimeShareOpt->getContentWrapper();
-
-    const int64_t timeShare = nextWrapper.getOrFail(DETAILS, TIME_SHARE)->getAs<int64_t>();
-    const int64_t startDateSec = nextTimeShareOpt->getStartDate().sec_since_epoch();
 
-    //If the time share doesn't belong to the claim period we
-    //finish pro-rating
-    if (periodEndSec - startDateSec <= 0)
-    {
-      break;
-    }
+  time_share_table timeline(get_self(), assignmentID);
 
-    int64_t remainingTimeSec;
+  //The time share active at the start of the period is the
+  //last one that started at or before it
+  auto it = timeline.upper_bound(periodStartSec);
 
-    lastUsedTimeShare = std::move(nextTimeShareOpt.value());
+  if (it != timeline.begin()) {
+    --it;
+  }
 
+  //Time shares starting at or after the period end don't belong to it
+  for (; it != timeline.end() && static_cast<int64_t>(it->start_sec) < periodEndSec; ++it)
+  {
     //It's possible that time share was set on previous periods,
     //if so we should use period start date as the base date
-    const int64_t baseDateSec = std::max(periodStartSec, startDateSec);
+    const int64_t baseDateSec = std::max(periodStartSec, static_cast<int64_t>(it->start_sec));
 
-    //Check if there is another timeshare
-    if ((nextTimeShareOpt = lastUsedTimeShare->getNext()))
-    {
-      const time_point commingStartDate = nextTimeShareOpt->getContentWrapper()
-                                                          .getOrFail(DETAILS, TIME_SHARE_START_DATE)
-                                                          ->getAs<time_point>();
-      const int64_t commingStartDateSec = commingStartDate.sec_since_epoch();
-      //Check if the time share belongs to the same peroid
-      if (commingStartDateSec >= periodEndSec)
-      {
-        remainingTimeSec = periodEndSec - baseDateSec;
-      }
-      else
-      {
-        remainingTimeSec = commingStartDateSec - baseDateSec;
-      }
-    }
-    else
-    {
-      remainingTimeSec = periodEndSec - baseDateSec;
-    }
+    //Time share is active until the next one starts or the period ends
+    auto next = std::next(it);
+
+    const int64_t endDateSec = next != timeline.end() ? 
+                               std::min(periodEndSec, static_cast<int64_t>(next->start_sec)) :
+                               periodEndSec;
+
+    const int64_t remainingTimeSec = endDateSec - baseDateSec;
 
     EOS_CHECK(remainingTimeSec >= 0, "Remaining time cannot be negative");
 
-    const int64_t fullPeriodSec = periodEndSec - periodStartSec;
+    lastUsedTimeShare = it->time_share_id;
 
-    //Time share could only represent a portion of the whole period
-    float relativeDuration = static_cast<float>(remainingTimeSec) / static_cast<float>(fullPeriodSec);
-    float relativeCommitment = static_cast<float>(timeShare) / static_cast<float>(initTimeShare);
-    float commitmentMultiplier = relativeDuration * relativeCommitment;
+    //Time share could only represent a portion of the whole period,
+    //the multiplier is (remaining / full period) * (time share / initial time share)
+    const int64_t multiplierNum = remainingTimeSec * it->time_share;
+    const int64_t multiplierDen = fullPeriodSec * initTimeShare;
 
     //Accumlate each of the currencies with the time share multiplier
 
-    payout.voice += adjustAsset(salary.voice, commitmentMultiplier);
-    if (daoTokens.peg.is_valid()) payout.peg += adjustAsset(salary.peg, commitmentMultiplier);
-    if (daoTokens.reward.is_valid()) payout.reward += adjustAsset(salary.reward, commitmentMultiplier);
+    payout.voice += adjustAsset(salary.voice, multiplierNum, multiplierDen);
+    if (daoTokens.peg.is_valid()) payout.peg += adjustAsset(salary.peg, multiplierNum, multiplierDen);
+    if (daoTokens.reward.is_valid()) payout.reward += adjustAsset(salary.reward, multiplierNum, multiplierDen);
   }
 
   return payout;
@@ -1118,18 +1189,6 @@ AssetBatch dao::calculatePeriodPayout(Period& period,
 //   return payAmount;
 // }
 
-asset dao::getProRatedAsset(ContentWrapper* assignment, const symbol& symbol, const string& key, const float& proration)
-{
-  TRACE_FUNCTION();
-  asset assetToPay = asset{ 0, symbol };
-  if (auto [idx, assetContent] = assignment->get(DETAILS, key); assetContent)
-  {
-    EOS_CHECK(std::holds_alternative<eosio::asset>(assetContent->value), "fatal error: expected token type must be an asset value type: " + assetContent->label);
-    assetToPay = std::get<eosio::asset>(assetContent->value);
-  }
-  return adjustAsset(assetToPay, proration);
-}
-
 void dao::makePayment(Settings* daoSettings,
   uint64_t fromNode,
   const eosio::name& recipient,
@@ -1145,11 +1204,138 @@ void dao::makePayment(Settings* daoSettings,
     return;
   }
 
-  std::unique_ptr<Payer> payer = std::unique_ptr<Payer>(PayerFactory::Factory(*this, daoSettings, quantity.symbol, paymentType, daoTokens));
-  Document paymentReceipt = payer->pay(recipient, quantity, memo);
-  Document recipientDoc(get_self(), getMemberID(recipient));
-  Edge::write(get_self(), get_self(), fromNode, paymentReceipt.getID(), common::PAYMENT);
-  Edge::write(get_self(), get_self(), recipientDoc.getID(), paymentReceipt.getID(), common::PAID);
+  PayerFactory::Factory(*this, daoSettings, quantity.symbol, paymentType, daoTokens)->pay(recipient, quantity, memo);
+
+  auto receiptID = recordPayments(
+    daoSettings, 
+    recipient, 
+    { quantity }, 
+    memo, 
+    Payer::defaultReceipt(recipient, quantity, memo, daoSettings->getRootID())
+  );
+
+  if (receiptID) {
+    Edge::write(get_self(), get_self(), fromNode, *receiptID, common::PAYMENT);
+    Edge::write(get_self(), get_self(), getMemberID(recipient), *receiptID, common::PAID);
+  }
+}
+
+void dao::makePayments(Settings* daoSettings,
+  uint64_t fromNode,
+  const eosio::name& recipient,
+  const AssetBatch& amounts,
+  const string& memo,
+  const eosio::name& paymentType,
+  const AssetBatch& daoTokens,
+  uint64_t periodID,
+  uint64_t lastPeriodID,
+  uint64_t assignmentID)
+{
+  TRACE_FUNCTION();
+
+  AssetBatch paid;
+  std::vector<asset> paidAmounts;
+
+  auto payToken = [&](const asset& quantity, asset& paidQuantity) {
+    // nothing to do if quantity is zero of symbol is USD, a known placeholder
+    if (!quantity.is_valid() || quantity.amount == 0 || quantity.symbol == common::S_USD) {
+      return;
+    }
+
+    PayerFactory::Factory(*this, daoSettings, quantity.symbol, paymentType, daoTokens)->pay(recipient, quantity, memo);
+
+    paidQuantity = quantity;
+    paidAmounts.push_back(quantity);
+  };
+
+  payToken(amounts.reward, paid.reward);
+  payToken(amounts.peg, paid.peg);
+  payToken(amounts.voice, paid.voice);
+
+  if (paidAmounts.empty()) {
+    return;
+  }
+
+  //All the tokens share a single receipt
+  auto receiptID = recordPayments(
+    daoSettings,
+    recipient,
+    paidAmounts,
+    memo,
+    paidAmounts.size() == 1 ? Payer::defaultReceipt(recipient, paidAmounts.front(), memo, daoSettings->getRootID()) :
+                              Payer::batchReceipt(recipient, paid, memo, daoSettings->getRootID()),
+    periodID,
+    lastPeriodID,
+    assignmentID
+  );
+
+  if (receiptID) {
+    Edge::write(get_self(), get_self(), fromNode, *receiptID, common::PAYMENT);
+    Edge::write(get_self(), get_self(), getMemberID(recipient), *receiptID, common::PAID);
+  }
+}
+
+std::optional<uint64_t> dao::recordPayments(Settings* daoSettings,
+  const eosio::name& recipient,
+  const std::vector<eosio::asset>& amounts,
+  const string& memo,
+  ContentGroups receipt,
+  uint64_t periodID,
+  uint64_t lastPeriodID,
+  uint64_t assignmentID)
+{
+  TRACE_FUNCTION();
+
+  payment_table payments(get_self(), daoSettings->getRootID());
+
+  payments.emplace(get_self(), [&](Payment& payment) {
+    payment.payment_id = payments.available_primary_key();
+    payment.payment_date = eosio::current_time_point();
+    payment.period_id = periodID;
+    payment.last_period_id = lastPeriodID;
+    payment.assignment_id = assignmentID;
+    payment.recipient = recipient;
+    payment.amounts = amounts;
+    payment.memo = memo;
+  });
+
+  if (daoSettings->getSettingOrDefault<int64_t>(common::PAYMENT_RECEIPTS, 1) == 0) {
+    return std::nullopt;
+  }
+
+  Document paymentReceipt(get_self(), get_self(), std::move(receipt));
+
+  return paymentReceipt.getID();
+}
+
+std::vector<dao::Payment> dao::getpayments(uint64_t dao_id, name index, uint64_t key, uint64_t from_id, uint64_t limit)
+{
+  payment_table payments(get_self(), dao_id);
+
+  std::vector<Payment> page;
+
+  auto collect = [&](auto&& idx, auto getKey) {
+    for (auto it = idx.lower_bound(Payment::build_key(key, from_id)); 
+         it != idx.end() && page.size() < limit && (getKey(*it) >> 64) == key; 
+         ++it) {
+      page.push_back(*it);
+    }
+  };
+
+  if (index == name("byperiod")) {
+    collect(payments.get_index<name("byperiod")>(), [](const Payment& p) { return p.by_period(); });
+  }
+  else if (index == name("byrecipient")) {
+    collect(payments.get_index<name("byrecipient")>(), [](const Payment& p) { return p.by_recipient(); });
+  }
+  else if (index == name("byassignment")) {
+    collect(payments.get_index<name("byassignment")>(), [](const Payment& p) { return p.by_assignment(); });
+  }
+  else {
+    EOS_CHECK(false, to_str("Unknown payments index: ", index));
+  }
+
+  return page;
 }
 
 void dao::apply(const eosio::name& applicant, uint64_t dao_id, const std::string& content)
@@ -1182,7 +1368,18 @@ void dao::enroll(const eosio::name& enroller, uint64_t dao_id, const eosio::name
 }
 
 bool dao::isPaused() {
-  return getSettingsDocument()->getSettingOrDefault<int64_t>("paused", 0) == 1;
+  if (!m_context.paused) {
+    m_context.paused = getSettingsDocument()->getSettingOrDefault<int64_t>("paused", 0) == 1;
+  }
+
+  return *m_context.paused;
+}
+
+void dao::resetRootSettingsContext()
+{
+  //Root settings changed, drop the values resolved from them
+  m_context.paused.reset();
+  m_context.contracts.clear();
 }
 
 Settings* dao::getSettingsDocument(uint64_t daoID)
@@ -1213,7 +1410,25 @@ Settings* dao::getSettingsDocument()
 {
   TRACE_FUNCTION();
 
-  return getSettingsDocument(getRootID());
+  if (!m_context.dhoSettings) {
+    m_context.dhoSettings = getSettingsDocument(getRootID());
+  }
+
+  return m_context.dhoSettings;
+}
+
+const eosio::name& dao::getContractName(const std::string& setting)
+{
+  auto it = m_context.contracts.find(setting);
+
+  if (it == m_context.contracts.end()) {
+    it = m_context.contracts.emplace(
+      setting, 
+      getSettingsDocument()->getOrFail<eosio::name>(setting)
+    ).first;
+  }
+
+  return it->second;
 }
 
 void dao::setsetting(const string& key, const Content::FlexValue& value, std::optional<std::string> group)
@@ -1223,6 +1438,8 @@ void dao::setsetting(const string& key, const Content::FlexValue& value, std::op
   auto settings = getSettingsDocument();
 
   settings->setSetting(group.value_or(string{ "settings" }), Content{ key, value });
+
+  resetRootSettingsContext();
 }
 
 void dao::setdaosetting(const uint64_t& dao_id, std::map<std::string, Content::FlexValue> kvs, std::optional<std::string> group)
@@ -1321,6 +1538,10 @@ void dao::setdaosetting(const uint64_t& dao_id, std::map<std::string, Content::F
   }
 
   settings->setSettings(groupName, kvs);
+
+  if (dao_id == getRootID()) {
+    resetRootSettingsContext();
+  }
 }
 
 //  void dao::adddaosetting(const uint64_t& dao_id, const std::string &key, const Content::FlexValue &value, std::optional<std::string> group)
@@ -1553,6 +1774,7 @@ void dao::remenroller(const uint64_t dao_id, name enroller_account)
   if (!remBadgePerm(*this, enroller_account, dao_id, badges::common::links::ENROLLER_BADGE)) {
     //If not just remove the permission
     Edge::get(get_self(), dao_id, getMemberID(enroller_account), common::ENROLLER).erase();
+    badges::setSystemBadge(*this, dao_id, getMemberID(enroller_account), badges::SystemBadgeType::Enroller, false);
   }
 
 }
@@ -1773,10 +1995,20 @@ void dao::remadmin(const uint64_t dao_id, name admin_account)
   if (!remBadgePerm(*this, admin_account, dao_id, badges::common::links::ADMIN_BADGE)) {
     //If not just remove the permission
     Edge::get(get_self(), dao_id, getMemberID(admin_account), common::ADMIN).erase();
+    badges::setSystemBadge(*this, dao_id, getMemberID(admin_account), badges::SystemBadgeType::Admin, false);
+#ifdef USE_TREASURY
+    treasury::Treasury::setAuthRole(*this, dao_id, admin_account, treasury::common::auth_roles::ADMIN, false);
+#endif
   }
 }
 
-void dao::genperiods(uint64_t dao_id, int64_t period_count/*, int64_t period_duration_sec*/)
+//Periods created by genperiods when the caller doesn't set max_per_call
+static constexpr int64_t DEFAULT_PERIODS_PER_CALL = 50;
+
+//Max value of max_per_call, larger extensions continue through the deferred queue
+static constexpr int64_t MAX_PERIODS_PER_CALL = 200;
+
+void dao::genperiods(uint64_t dao_id, int64_t period_count, const eosio::binary_extension<int64_t>& max_per_call)
 {
   TRACE_FUNCTION();
   EOS_CHECK(!isPaused(), "Contract is paused for maintenance. Please try again later.");
@@ -1812,7 +2044,7 @@ void dao::genperiods(uint64_t dao_id, int64_t period_count/*, int64_t period_dur
   
   std::string owner = isRoot ? "Root Node" : to_str(settings->getOrFail<eosio::name>(DAO_NAME));
 
-  genPeriods(owner, periodDurationSecs, dao_id, calendarId, period_count);
+  genPeriods(owner, periodDurationSecs, dao_id, calendarId, period_count, max_per_call.value_or(DEFAULT_PERIODS_PER_CALL));
 }
 
 ACTION dao::createcalen(bool is_default)
@@ -1837,6 +2069,8 @@ ACTION dao::createcalen(bool is_default)
     Edge(get_self(), get_self(), calendarDoc.getID(), newPeriod.getID(), common::PERIOD);
     Edge(get_self(), get_self(), newPeriod.getID(), calendarDoc.getID(), common::CALENDAR);
 
+    Period::appendToCalendar(this, calendarDoc.getID(), std::nullopt, newPeriod);
+
     const auto rootId = getRootID();
 
     Edge(get_self(), get_self(), rootId, calendarDoc.getID(), name(common::CALENDAR_WEEK));
@@ -1852,7 +2086,7 @@ ACTION dao::createcalen(bool is_default)
       INIT_PERIOD_COUNT = *count;
     }
     
-    genperiods(rootId, INIT_PERIOD_COUNT);
+    genperiods(rootId, INIT_PERIOD_COUNT, MAX_PERIODS_PER_CALL);
   }
 }
 
@@ -1895,6 +2129,104 @@ ACTION dao::initcalendar(uint64_t calendar_id, uint64_t next_period)
   }
 }
 
+ACTION dao::indexcalen(uint64_t calendar_id)
+{
+  eosio::require_auth(get_self());
+
+  TypedDocument::withType(*this, calendar_id, common::CALENDAR);
+
+  calendar_table calendar(get_self(), get_self().value);
+
+  auto byIndex = calendar.get_index<name("byindex")>();
+
+  //Resume after the last indexed period of the calendar
+  auto lastIt = byIndex.lower_bound(CalendarPeriod::build_key(calendar_id + 1, 0));
+
+  std::optional<Period> lastPeriod;
+
+  if (lastIt != byIndex.begin() && (--lastIt)->calendar_id == calendar_id) {
+    lastPeriod.emplace(this, lastIt->period_id);
+  }
+  else {
+    Period startPeriod(this, Edge::get(get_self(), calendar_id, common::START).getToNode());
+    Period::appendToCalendar(this, calendar_id, std::nullopt, startPeriod);
+    lastPeriod = startPeriod;
+  }
+
+  const size_t MAX_ITS_PER_ACTION = 50;
+
+  size_t i = 0;
+
+  auto nextPeriod = lastPeriod->nextOpt();
+
+  while (nextPeriod && i++ < MAX_ITS_PER_ACTION) {
+    Period::appendToCalendar(this, calendar_id, lastPeriod->getID(), *nextPeriod);
+
+    lastPeriod = nextPeriod;
+    nextPeriod = nextPeriod->nextOpt();
+  }
+
+  //Each page runs in its own transaction so progress is kept between pages
+  if (nextPeriod) {
+    eosio::action act(
+      eosio::permission_level(get_self(), eosio::name("active")),
+      get_self(),
+      eosio::name("indexcalen"),
+      std::make_tuple(calendar_id)
+    );
+
+    schedule_deferred_action(eosio::time_point_sec(eosio::current_time_point()), act);
+  }
+}
+
+ACTION dao::clearvotes(uint64_t proposal_id)
+{
+  eosio::require_auth(get_self());
+
+  Vote::eraseVotes(*this, proposal_id);
+}
+
+ACTION dao::indexmembers(uint64_t dao_id, name from)
+{
+  eosio::require_auth(get_self());
+
+  verifyDaoType(dao_id);
+
+  const size_t MAX_ITS_PER_ACTION = 50;
+
+  //Each page runs in its own transaction so progress is kept between pages
+  if (auto next = Member::indexMembership(*this, dao_id, from, MAX_ITS_PER_ACTION)) {
+    eosio::action act(
+      eosio::permission_level(get_self(), eosio::name("active")),
+      get_self(),
+      eosio::name("indexmembers"),
+      std::make_tuple(dao_id, *next)
+    );
+
+    schedule_deferred_action(eosio::time_point_sec(eosio::current_time_point()), act);
+  }
+}
+
+ACTION dao::indexbadges(uint64_t dao_id, name from)
+{
+  eosio::require_auth(get_self());
+
+  verifyDaoType(dao_id);
+
+  const size_t MAX_ITS_PER_ACTION = 20;
+
+  if (auto next = badges::indexBadges(*this, dao_id, from, MAX_ITS_PER_ACTION)) {
+    eosio::action act(
+      eosio::permission_level(get_self(), eosio::name("active")),
+      get_self(),
+      eosio::name("indexbadges"),
+      std::make_tuple(dao_id, *next)
+    );
+
+    schedule_deferred_action(eosio::time_point_sec(eosio::current_time_point()), act);
+  }
+}
+
 static void initCoreMembers(dao& dao, uint64_t daoID, eosio::name onboarder, ContentWrapper config) 
 {
   std::set<eosio::name> coreMemNames = { onboarder };
@@ -1981,6 +2313,9 @@ void dao::createdao(ContentGroups& config)
     //between different Ecosystems
     addNameID<dao_table>(dao, daoDoc.getID());
 
+    Member::initMembershipIndex(*this, daoDoc.getID());
+    badges::initBadgeIndex(*this, daoDoc.getID());
+
     //Extract mandatory configurations from DraftDao if present, or use the
     //configCW items if not
     if (auto draftDao = configCW.get(DETAILS, common::DAO_DRAFT_ID).second) {
@@ -2321,6 +2656,9 @@ void dao::createroot(const std::string& notes)
 
   addNameID<dao_table>(common::DHO_ROOT_NAME, rootDoc.getID());
 
+  Member::initMembershipIndex(*this, rootDoc.getID());
+  badges::initBadgeIndex(*this, rootDoc.getID());
+
   getOrCreateMember(get_self());
 
   initSysBadges();
@@ -2850,6 +3188,8 @@ void dao::modifyCommitment(RecurringActivity& assignment, int64_t commitment, st
 
   TimeShare lastTimeShare(get_self(), lastTimeShareEdge.getToNode());
 
+  TimeShare::initTimeline(get_self(), assignment.getID());
+
   time_point lastStartDate = lastTimeShare.getStartDate();
 
   if (fixedStartDate)
@@ -2887,10 +3227,16 @@ void dao::modifyCommitment(RecurringActivity& assignment, int64_t commitment, st
 
   Edge::write(get_self(), get_self(), assignment.getID(), newTimeShareDoc.getID(), common::LAST_TIME_SHARE);
   Edge::write(get_self(), get_self(), assignment.getID(), newTimeShareDoc.getID(), common::TIME_SHARE_LABEL);
+
+  newTimeShareDoc.addToTimeline(assignment.getID());
 }
 
 uint64_t dao::getRootID() const
 {
+  if (m_context.rootID) {
+    return *m_context.rootID;
+  }
+
   auto rootID = getDAOID(common::DHO_ROOT_NAME);
 
   //Verify root entry exists
@@ -2899,6 +3245,8 @@ uint64_t dao::getRootID() const
     to_str("Missing root document entry")
   );
 
+  m_context.rootID = rootID;
+
   return *rootID;
 }
 
@@ -2942,8 +3290,8 @@ void dao::checkEnrollerAuth(uint64_t dao_id, const name& account)
   auto memberID = getMemberID(account);
 
   EOS_CHECK(
-    Edge::exists(get_self(), dao_id, memberID, common::ENROLLER) ||
-    Edge::exists(get_self(), dao_id, memberID, common::ADMIN),
+    badges::hasEnrollerBadge(*this, dao_id, memberID) ||
+    badges::hasAdminBadge(*this, dao_id, memberID),
     to_str("Only enrollers of the dao are allowed to perform this action")
   );
 }
@@ -2968,13 +3316,12 @@ void dao::checkAdminsAuth(uint64_t dao_id)
   );
 }
 
-void dao::genPeriods(const std::string& owner, int64_t periodDuration, uint64_t ownerId, uint64_t calendarId, int64_t periodCount/*, int64_t period_duration_sec*/)
+void dao::genPeriods(const std::string& owner, int64_t periodDuration, uint64_t ownerId, uint64_t calendarId, int64_t periodCount, int64_t maxPerCall)
 {
-  //Max number of periods that should be created in one call
-  const int64_t MAX_PERIODS_PER_CALL = 20;
-
-  //Get last period
-  //Document daoDoc(get_self(), dao_id);  
+  EOS_CHECK(
+    maxPerCall > 0 && maxPerCall <= MAX_PERIODS_PER_CALL,
+    to_str("max_per_call must be between 1 and ", MAX_PERIODS_PER_CALL)
+  );
 
   auto lastEdge = Edge::get(get_self(), calendarId, common::END);
 
@@ -2982,22 +3329,40 @@ void dao::genPeriods(const std::string& owner, int64_t periodDuration, uint64_t
 
   uint64_t lastPeriodID = lastEdge.getToNode();
 
-  int64_t lastPeriodStartSecs = Period(this, lastPeriodID)
-    .getStartTime()
-    .sec_since_epoch();
+  calendar_table calendar(get_self(), get_self().value);
+
+  auto lastRow = calendar.find(lastPeriodID);
+
+  //Periods of indexed calendars are resolved through the calendar table,
+  //so they only need the period document and the NEXT edge
+  const bool isIndexed = lastRow != calendar.end();
+
+  int64_t lastPeriodStartSecs = isIndexed ? 
+                                lastRow->start_sec : 
+                                Period(this, lastPeriodID).getStartTime().sec_since_epoch();
+
+  const int64_t count = std::min(maxPerCall, periodCount);
 
-  for (int64_t i = 0; i < std::min(MAX_PERIODS_PER_CALL, periodCount); ++i) {
+  const std::string labelPrefix = owner + ": ";
+
+  for (int64_t i = 0; i < count; ++i) {
     time_point nextPeriodStart(eosio::seconds(lastPeriodStartSecs + periodDuration));
 
     Period nextPeriod(
       this,
       nextPeriodStart,
-      to_str(owner, ": ", nextPeriodStart.time_since_epoch().count())
+      labelPrefix + std::to_string(nextPeriodStart.time_since_epoch().count())
     );
 
     Edge(get_self(), get_self(), lastPeriodID, nextPeriod.getID(), common::NEXT);
-    Edge(get_self(), get_self(), calendarId, nextPeriod.getID(), common::PERIOD);
-    Edge(get_self(), get_self(), nextPeriod.getID(), calendarId, common::CALENDAR);
+
+    if (isIndexed) {
+      Period::appendToCalendar(this, calendarId, lastPeriodID, nextPeriod);
+    }
+    else {
+      Edge(get_self(), get_self(), calendarId, nextPeriod.getID(), common::PERIOD);
+      Edge(get_self(), get_self(), nextPeriod.getID(), calendarId, common::CALENDAR);
+    }
 
     lastPeriodStartSecs = nextPeriodStart.sec_since_epoch();
     lastPeriodID = nextPeriod.getID();
@@ -3005,17 +3370,20 @@ void dao::genPeriods(const std::string& owner, int64_t periodDuration, uint64_t
 
   Edge(get_self(), get_self(), calendarId, lastPeriodID, common::END);
 
-  //Check if there are more periods to created
-  if (periodCount > MAX_PERIODS_PER_CALL) {
-    eosio::action(
+  //Each chunk runs in its own transaction so the limit bounds the work of each one
+  if (periodCount > count) {
+    eosio::action act(
       eosio::permission_level(get_self(), eosio::name("active")),
       get_self(),
       eosio::name("genperiods"),
       std::make_tuple(
         ownerId,
-        periodCount - MAX_PERIODS_PER_CALL
+        periodCount - count,
+        eosio::binary_extension<int64_t>(maxPerCall)
       )
-    ).send();
+    );
+
+    schedule_deferred_action(eosio::time_point_sec(eosio::current_time_point()), act);
   }
 }
 
@@ -3024,8 +3392,7 @@ void dao::createVoiceToken(const eosio::name& daoName,
   const uint64_t& decayPeriod,
   const uint64_t& decayPerPeriodx10M)
 {
-  auto dhoSettings = getSettingsDocument();
-  name governanceContract = dhoSettings->getOrFail<eosio::name>(GOVERNANCE_TOKEN_CONTRACT);
+  name governanceContract = getContractName(GOVERNANCE_TOKEN_CONTRACT);
 
   eosio::action(
     eosio::permission_level{ governanceContract, name("active") },
@@ -3044,9 +3411,7 @@ void dao::createVoiceToken(const eosio::name& daoName,
 
 void dao::createToken(const std::string& contractType, name issuer, const asset& token)
 {
-  auto dhoSettings = getSettingsDocument();
-
-  name contract = dhoSettings->getOrFail<eosio::name>(contractType);
+  name contract = getContractName(contractType);
 
   eosio::action(
     eosio::permission_level{ contract, name("active") },
@@ -3140,7 +3505,7 @@ void dao::updateDaoURL(name dao, const Content::FlexValue& newURL)
 
 void dao::changeDecay(Settings* dhoSettings, Settings* daoSettings, uint64_t decayPeriod, uint64_t decayPerPeriod)
 {
-  auto voiceContract = dhoSettings->getOrFail<name>(GOVERNANCE_TOKEN_CONTRACT);
+  auto voiceContract = getContractName(GOVERNANCE_TOKEN_CONTRACT);
   
   eosio::action(
     eosio::permission_level{
@@ -3187,6 +3552,7 @@ void dao::addDefaultSettings(ContentGroup& settingsGroup, const string& daoTitle
   sg.push_back({ common::DAO_ORGANISATION_PARAGRAPH, "Select from a multitude of tools to finetune how the organization works. From treasury and compensation to decision-making, from roles to badges, you have every lever at your fingertips." });
   sg.push_back({ common::ADD_ADMINS_ENABLED, int64_t(1) });
   sg.push_back({ common::CLAIM_ENABLED, int64_t(1) });
+  sg.push_back({ common::VOICE_SNAPSHOT, int64_t(1) });
 }
 
 void dao::pushRewardTokenSettings(name dao, uint64_t daoID, ContentGroup& settingsGroup, ContentWrapper configCW, int64_t detailsIdx, bool create) {
@@ -3508,9 +3874,13 @@ void dao::reset() {
   delete_table<election_vote_table>(get_self(), 2);
   delete_table<election_vote_table>(get_self(), 3);
   delete_table<token_to_dao_table>(get_self(), get_self().value);
+  //Payments are scoped by DAO
+  dao_table daos(get_self(), get_self().value);
+  for (auto& daoEntry : daos) {
+    delete_table<payment_table>(get_self(), daoEntry.id);
+  }
   delete_table<dao_table>(get_self(), get_self().value);
   delete_table<member_table>(get_self(), get_self().value);
-  delete_table<payment_table>(get_self(), get_self().value);
   delete_table<Document::document_table>(get_self(), get_self().value);
   delete_table<Edge::edge_table>(get_self(), get_self().value);
   delete_table<deferred_actions_tables>(get_self(), get_self().value);
@@ -3519,6 +3889,12 @@ void dao::reset() {
 
 }
 
+//Claims of a deferred action before it's moved to the dead letter table
+static constexpr uint32_t MAX_DEFERRED_ATTEMPTS = 3;
+
+//Time a claimed deferred action is hidden from executebatch
+static constexpr uint32_t DEFERRED_CLAIM_SECS = 60;
+
 // Action to choose and execute the next action
 // Note: anybody can call this - fails if there is no action to execute.
 void dao::executenext() {
@@ -3529,16 +3905,7 @@ void dao::executenext() {
     auto itr = idx.begin();
 
     if (itr != idx.end() && itr->execute_time <= eosio::current_time_point()) {
-
-        // Note: We can't use the public constructor because it will misinterpret the 
-        // data and pack it again - data is already in packed format. 
-        eosio::action act;
-        act.account = itr->account;
-        act.name = itr->action_name;
-        act.authorization = itr->auth;
-        act.data = itr->data;
-
-        act.send();
+        runDeferred(*itr);
 
         idx.erase(itr);
     }
@@ -3547,7 +3914,86 @@ void dao::executenext() {
     }
 }
 
-// pick the next executable action, and delete it
+// Claims up to max_actions due actions so each one runs in its own transaction
+// with executedtx, a failing action then can't revert the others.
+// Claiming counts an attempt and hides the action for DEFERRED_CLAIM_SECS, actions 
+// still queued after MAX_DEFERRED_ATTEMPTS claims are moved to the dead letter table.
+// Note: anybody can call this - fails if there is no action to claim.
+std::vector<uint64_t> dao::executebatch(uint64_t max_actions) {
+    EOS_CHECK(
+      max_actions > 0,
+      "max_actions must be greater than 0"
+    );
+
+    deferred_actions_tables deftrx(get_self(), get_self().value);
+
+    auto idx = deftrx.get_index<"bytime"_n>();
+    auto now = eosio::time_point_sec(eosio::current_time_point());
+
+    std::vector<uint64_t> claimed;
+    uint64_t deadLettered = 0;
+
+    for (auto itr = idx.begin(); 
+         claimed.size() < max_actions && itr != idx.end() && itr->execute_time <= now;
+         itr = idx.begin()) {
+
+        auto attempts = itr->attempts.value_or(0);
+
+        if (attempts >= MAX_DEFERRED_ATTEMPTS) {
+            deadLetter(deftrx, deftrx.find(itr->id));
+            ++deadLettered;
+            continue;
+        }
+
+        claimed.push_back(itr->id);
+
+        idx.modify(itr, get_self(), [&](auto& row) {
+            row.execute_time = now + DEFERRED_CLAIM_SECS;
+            row.retries.emplace(row.retries.value_or(0));
+            row.attempts.emplace(attempts + 1);
+        });
+    }
+
+    eosio::check(!claimed.empty() || deadLettered > 0, "No deferred actions to execute at this time.");
+
+    return claimed;
+}
+
+// Executes a deferred action claimed by executebatch
+// Note: anybody can call this
+void dao::executedtx(uint64_t id) {
+
+    deferred_actions_tables deftrx(get_self(), get_self().value);
+    auto itr = deftrx.find(id);
+
+    EOS_CHECK(
+      itr != deftrx.end(),
+      to_str("Deferred action not found: ", id)
+    );
+
+    EOS_CHECK(
+      itr->attempts.value_or(0) > 0,
+      to_str("Deferred action was not claimed: ", id)
+    );
+
+    runDeferred(*itr);
+
+    deftrx.erase(itr);
+}
+
+void dao::runDeferred(const deferred_actions_table& deferred) {
+    // Note: We can't use the public constructor because it will misinterpret the 
+    // data and pack it again - data is already in packed format. 
+    eosio::action act;
+    act.account = deferred.account;
+    act.name = deferred.action_name;
+    act.authorization = deferred.auth;
+    act.data = deferred.data;
+
+    act.send();
+}
+
+// pick the next executable action, and move it to the dead letter table
 // This is to be used when the scheduler is stalled due to transactions failing.
 void dao::removedtx() {
     // there should be a special permission for a serivce account set up to call this
@@ -3558,13 +4004,85 @@ void dao::removedtx() {
     auto idx = deftrx.get_index<"bytime"_n>();
     auto itr = idx.begin();
     if (itr != idx.end() && itr->execute_time <= eosio::current_time_point()) {
-        idx.erase(itr);
+        deadLetter(deftrx, deftrx.find(itr->id));
     }
     else {
         eosio::check(false, "No deferred actions to execute at this time.");
     }
 }
 
+void dao::deadlettrx(uint64_t id) {
+    require_auth(get_self());
+
+    deferred_actions_tables deftrx(get_self(), get_self().value);
+    auto itr = deftrx.find(id);
+
+    EOS_CHECK(
+      itr != deftrx.end(),
+      to_str("Deferred action not found: ", id)
+    );
+
+    deadLetter(deftrx, itr);
+}
+
+void dao::deadLetter(deferred_actions_tables& deftrx, deferred_actions_tables::const_iterator itr) {
+    
+    dead_actions_tables deadtrx(get_self(), get_self().value);
+
+    deadtrx.emplace(get_self(), [&](auto& row) {
+        row.id = deadtrx.available_primary_key();
+        row.execute_time = itr->execute_time;
+        row.failed_time = eosio::current_time_point();
+        row.auth = itr->auth;
+        row.account = itr->account;
+        row.action_name = itr->action_name;
+        row.data = itr->data;
+        row.retries = itr->retries.value_or(0) + 1;
+    });
+
+    deftrx.erase(itr);
+}
+
+// Schedule a dead letter action to run with the next batch
+void dao::retrydtx(uint64_t id) {
+    require_auth(get_self());
+
+    dead_actions_tables deadtrx(get_self(), get_self().value);
+    auto itr = deadtrx.find(id);
+
+    EOS_CHECK(
+      itr != deadtrx.end(),
+      to_str("Dead letter action not found: ", id)
+    );
+
+    deferred_actions_tables deftrx(get_self(), get_self().value);
+
+    deftrx.emplace(get_self(), [&](auto& row) {
+        row.id = deftrx.available_primary_key();
+        row.execute_time = eosio::current_time_point();
+        row.auth = itr->auth;
+        row.account = itr->account;
+        row.action_name = itr->action_name;
+        row.data = itr->data;
+        row.retries = itr->retries;
+    });
+
+    deadtrx.erase(itr);
+}
+
+void dao::dropdtx(uint64_t id) {
+    require_auth(get_self());
+
+    dead_actions_tables deadtrx(get_self(), get_self().value);
+    auto itr = deadtrx.find(id);
+
+    EOS_CHECK(
+      itr != deadtrx.end(),
+      to_str("Dead letter action not found: ", id)
+    );
+
+    deadtrx.erase(itr);
+}
 
 // Add a new deferred transaction
 void dao::schedule_deferred_action(eosio::time_point_sec execute_time, eosio::action action) {
@@ -0,0 +1,81 @@
+#include <fixed_point.hpp>
+
+#include <limits>
+
+#include <logger/logger.hpp>
+#include <util.hpp>
+
+namespace hypha::fixed
+{
+    using int128 = int128_t;
+
+    static constexpr int128 INT128_MAX_VAL = static_cast<int128>(~static_cast<uint128_t>(0) >> 1);
+
+    static int128 abs128(int128 value)
+    {
+        return value < 0 ? -value : value;
+    }
+
+    static int64_t mulDiv128(int64_t value, int128 num, int128 den)
+    {
+        EOS_CHECK(den != 0, "Fixed point division by zero");
+
+        EOS_CHECK(
+            num == 0 || abs128(value) <= INT128_MAX_VAL / abs128(num),
+            to_str("Fixed point overflow multiplying ", value)
+        );
+
+        int128 result = static_cast<int128>(value) * num / den;
+
+        EOS_CHECK(
+            result <= std::numeric_limits<int64_t>::max() &&
+            result >= std::numeric_limits<int64_t>::min(),
+            to_str("Fixed point result out of range for ", value)
+        );
+
+        return static_cast<int64_t>(result);
+    }
+
+    int64_t pow10(uint8_t exp)
+    {
+        EOS_CHECK(
+            exp < POW10.size(),
+            to_str("Precision out of range: ", static_cast<int>(exp))
+        );
+
+        return POW10[exp];
+    }
+
+    int64_t mulDiv(int64_t value, int64_t num, int64_t den)
+    {
+        return mulDiv128(value, num, den);
+    }
+
+    eosio::asset scale(const eosio::asset& amount, int64_t num, int64_t den)
+    {
+        return eosio::asset{ mulDiv(amount.amount, num, den), amount.symbol };
+    }
+
+    eosio::asset convert(const eosio::asset& amount, const eosio::symbol& symbol, int64_t num, int64_t den)
+    {
+        int128 num128 = num;
+        int128 den128 = den;
+
+        auto from = amount.symbol.precision();
+        auto to = symbol.precision();
+
+        if (to > from) {
+            num128 *= pow10(to - from);
+        }
+        else {
+            den128 *= pow10(from - to);
+        }
+
+        return eosio::asset{ mulDiv128(amount.amount, num128, den128), symbol };
+    }
+
+    eosio::asset units(int64_t count, const eosio::symbol& symbol)
+    {
+        return eosio::asset{ mulDiv(count, pow10(symbol.precision()), 1), symbol };
+    }
+}
@@ -43,14 +43,242 @@ namespace hypha
 
     bool Member::isMember(dao& dao, uint64_t daoID, const eosio::name &member)
     {        
+        if (auto isMember = hasMembership(dao, daoID, member, membership::CORE)) {
+            return *isMember;
+        }
+
         return Edge::exists(dao.get_self(), daoID, dao.getMemberID(member), common::MEMBER);
     }
 
     bool Member::isCommunityMember(dao& dao, uint64_t daoID, const eosio::name &member)
     {
+        if (auto isMember = hasMembership(dao, daoID, member, membership::COMMUNITY)) {
+            return *isMember;
+        }
+
         return Edge::exists(dao.get_self(), daoID, dao.getMemberID(member), common::COMMEMBER);
     }
 
+    std::optional<bool> Member::hasMembership(dao& dao, uint64_t daoID, const eosio::name& account, uint8_t flag)
+    {
+        dao::membership_table memberships(dao.get_self(), daoID);
+
+        if (auto it = memberships.find(account.value); it != memberships.end()) {
+            return (it->flags & flag) != 0;
+        }
+
+        dao::membership_stats_table stats(dao.get_self(), dao.get_self().value);
+
+        //Until the DAO is indexed accounts without a row might still have membership edges
+        if (auto statsIt = stats.find(daoID); statsIt != stats.end() && statsIt->indexed) {
+            return false;
+        }
+
+        return std::nullopt;
+    }
+
+    void Member::setMembership(dao& dao, uint64_t daoID, const eosio::name& account, uint8_t flag, bool value)
+    {
+        dao::membership_table memberships(dao.get_self(), daoID);
+
+        auto it = memberships.find(account.value);
+
+        uint8_t flags = it != memberships.end() ? it->flags : 0;
+        uint64_t memberID = it != memberships.end() ? it->member_id : dao.getMemberID(account);
+
+        //Accounts of DAOs that aren't indexed yet might only have membership edges
+        if (it == memberships.end()) {
+            dao::membership_stats_table stats(dao.get_self(), dao.get_self().value);
+
+            if (auto statsIt = stats.find(daoID); statsIt == stats.end() || !statsIt->indexed) {
+                flags = indexAccount(dao, daoID, account, memberID);
+            }
+        }
+
+        writeMembership(dao, daoID, account, memberID, value ? (flags | flag) : (flags & ~flag));
+    }
+
+    uint8_t Member::indexAccount(dao& dao, uint64_t daoID, const eosio::name& account, uint64_t memberID)
+    {
+        uint8_t flags = 0;
+
+        if (Edge::exists(dao.get_self(), daoID, memberID, common::MEMBER)) {
+            flags |= membership::CORE;
+            //Keep the original join order
+            auto joined = Edge::get(dao.get_self(), daoID, memberID, common::MEMBER).getCreated();
+            writeCoreMember(dao, daoID, account, memberID, true, joined);
+        }
+
+        if (Edge::exists(dao.get_self(), daoID, memberID, common::COMMEMBER)) {
+            flags |= membership::COMMUNITY;
+        }
+
+        if (Edge::exists(dao.get_self(), daoID, memberID, common::APPLICANT)) {
+            flags |= membership::APPLICANT;
+        }
+
+        writeMembership(dao, daoID, account, memberID, flags);
+
+        return flags;
+    }
+
+    void Member::writeMembership(dao& dao, uint64_t daoID, const eosio::name& account, uint64_t memberID, uint8_t flags)
+    {
+        dao::membership_table memberships(dao.get_self(), daoID);
+
+        auto it = memberships.find(account.value);
+
+        uint8_t oldFlags = it != memberships.end() ? it->flags : 0;
+
+        if (oldFlags == flags) {
+            return;
+        }
+
+        if (it == memberships.end()) {
+            memberships.emplace(dao.get_self(), [&](dao::Membership& row) {
+                row.account = account;
+                row.member_id = memberID;
+                row.flags = flags;
+            });
+        }
+        else if (flags == 0) {
+            memberships.erase(it);
+        }
+        else {
+            memberships.modify(it, dao.get_self(), [&](dao::Membership& row) {
+                row.flags = flags;
+            });
+        }
+
+        if ((oldFlags ^ flags) & membership::CORE) {
+            writeCoreMember(dao, daoID, account, memberID, flags & membership::CORE, eosio::current_time_point());
+        }
+
+        dao::membership_stats_table stats(dao.get_self(), dao.get_self().value);
+
+        auto statsIt = stats.find(daoID);
+
+        if (statsIt == stats.end()) {
+            statsIt = stats.emplace(dao.get_self(), [&](dao::MembershipStats& row) {
+                row.dao_id = daoID;
+                row.core_members = 0;
+                row.community_members = 0;
+                row.applicants = 0;
+                row.indexed = false;
+            });
+        }
+
+        auto updateCounter = [&](uint64_t& counter, uint8_t flag) {
+            bool had = oldFlags & flag;
+            bool has = flags & flag;
+            if (had && !has) {
+                --counter;
+            }
+            else if (!had && has) {
+                ++counter;
+            }
+        };
+
+        stats.modify(statsIt, dao.get_self(), [&](dao::MembershipStats& row) {
+            updateCounter(row.core_members, membership::CORE);
+            updateCounter(row.community_members, membership::COMMUNITY);
+            updateCounter(row.applicants, membership::APPLICANT);
+        });
+    }
+
+    void Member::writeCoreMember(dao& dao, uint64_t daoID, const eosio::name& account, uint64_t memberID, bool isCore, const eosio::time_point& joined)
+    {
+        dao::core_member_table coreMembers(dao.get_self(), daoID);
+
+        auto it = coreMembers.find(memberID);
+
+        if (isCore && it == coreMembers.end()) {
+            coreMembers.emplace(dao.get_self(), [&](dao::CoreMember& row) {
+                row.member_id = memberID;
+                row.account = account;
+                row.joined = joined;
+            });
+        }
+        else if (!isCore && it != coreMembers.end()) {
+            coreMembers.erase(it);
+        }
+    }
+
+    std::optional<uint64_t> Member::getMemberCount(dao& dao, uint64_t daoID, uint8_t flags)
+    {
+        dao::membership_stats_table stats(dao.get_self(), dao.get_self().value);
+
+        auto statsIt = stats.find(daoID);
+
+        if (statsIt == stats.end() || !statsIt->indexed) {
+            return std::nullopt;
+        }
+
+        uint64_t count = 0;
+
+        if (flags & membership::CORE) {
+            count += statsIt->core_members;
+        }
+
+        if (flags & membership::COMMUNITY) {
+            count += statsIt->community_members;
+        }
+
+        if (flags & membership::APPLICANT) {
+            count += statsIt->applicants;
+        }
+
+        return count;
+    }
+
+    void Member::initMembershipIndex(dao& dao, uint64_t daoID)
+    {
+        dao::membership_stats_table stats(dao.get_self(), dao.get_self().value);
+
+        EOS_CHECK(
+            stats.find(daoID) == stats.end(),
+            to_str("Membership index already exists for DAO: ", daoID)
+        );
+
+        stats.emplace(dao.get_self(), [&](dao::MembershipStats& row) {
+            row.dao_id = daoID;
+            row.core_members = 0;
+            row.community_members = 0;
+            row.applicants = 0;
+            row.indexed = true;
+        });
+    }
+
+    std::optional<eosio::name> Member::indexMembership(dao& dao, uint64_t daoID, const eosio::name& from, size_t maxMembers)
+    {
+        dao::member_table members(dao.get_self(), dao.get_self().value);
+
+        auto it = members.lower_bound(from.value);
+
+        for (size_t i = 0; it != members.end() && i < maxMembers; ++it, ++i) {
+            indexAccount(dao, daoID, it->name, it->id);
+        }
+
+        if (it != members.end()) {
+            return it->name;
+        }
+
+        dao::membership_stats_table stats(dao.get_self(), dao.get_self().value);
+
+        auto statsIt = stats.find(daoID);
+
+        if (statsIt == stats.end()) {
+            initMembershipIndex(dao, daoID);
+        }
+        else {
+            stats.modify(statsIt, dao.get_self(), [](dao::MembershipStats& row) {
+                row.indexed = true;
+            });
+        }
+
+        return std::nullopt;
+    }
+
     bool Member::exists(dao& dao, const eosio::name& memberName)
     {
         dao::member_table m_t(dao.get_self(), dao.get_self().value);
@@ -69,6 +297,8 @@ namespace hypha
 
         Edge::write(getContract(), getAccount(), applyTo, getID(), common::APPLICANT);
         Edge::write(getContract(), getAccount(), getID(), applyTo, common::APPLICANT_OF);
+
+        setMembership(m_dao, applyTo, getAccount(), membership::APPLICANT, true);
     }
 
     void Member::enroll(const eosio::name &enroller, uint64_t appliedTo, const std::string &content)
@@ -92,6 +322,9 @@ namespace hypha
         Edge applicantRootEdge = Edge::get(getContract(), getID(), rootID, common::APPLICANT_OF);
         applicantRootEdge.erase();
 
+        setMembership(m_dao, rootID, getAccount(), membership::CORE, true);
+        setMembership(m_dao, rootID, getAccount(), membership::APPLICANT, false);
+
         // TODO: add as configuration setting for genesis amount
         // TODO: connect the payment receipt to the period also
         // TODO: change Payer.hpp to NOT require m_dao so this payment can be made using payer factory
@@ -112,7 +345,7 @@ namespace hypha
         eosio::asset genesis_voice{getTokenUnit(voiceToken), voiceToken.symbol};
         std::string memo = to_str("genesis voice issuance during enrollment to ", daoName);
 
-        name hyphaHvoice = m_dao.getSettingOrFail<eosio::name>(GOVERNANCE_TOKEN_CONTRACT);
+        name hyphaHvoice = m_dao.getContractName(GOVERNANCE_TOKEN_CONTRACT);
 
         hypha::issueTenantToken(
             hyphaHvoice,
@@ -123,9 +356,17 @@ namespace hypha
             memo
         );
 
-        Document paymentReceipt(getContract(), getContract(), Payer::defaultReceipt(getAccount(), genesis_voice, memo, rootID));
+        auto receiptID = m_dao.recordPayments(
+            daoSettings,
+            getAccount(),
+            { genesis_voice },
+            memo,
+            Payer::defaultReceipt(getAccount(), genesis_voice, memo, rootID)
+        );
 
-        Edge::write(getContract(), getAccount(), getID(), paymentReceipt.getID(), common::PAYMENT);
+        if (receiptID) {
+            Edge::write(getContract(), getAccount(), getID(), *receiptID, common::PAYMENT);
+        }
 
         // eosio::action(
         //     eosio::permission_level{ getContract(), name("active") },
@@ -153,6 +394,8 @@ namespace hypha
     {
         Edge::get(m_dao.get_self(), daoID, getID(), common::MEMBER).erase();
         Edge::get(m_dao.get_self(), getID(), daoID, common::MEMBER_OF).erase();
+
+        setMembership(m_dao, daoID, getAccount(), membership::CORE, false);
     }
 
 } // namespace hypha
\ No newline at end of file
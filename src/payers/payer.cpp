@@ -12,13 +12,13 @@ namespace hypha
     }
     Payer::~Payer() {}
 
-    Document Payer::pay(const eosio::name &recipient,
-                        const eosio::asset &quantity,
-                        const string &memo)
+    void Payer::pay(const eosio::name &recipient,
+                    const eosio::asset &quantity,
+                    const string &memo)
 
     {
         TRACE_FUNCTION()
-        return payImpl(recipient, quantity, memo);
+        payImpl(recipient, quantity, memo);
     }
 
     void Payer::issueToken(const eosio::name &token_contract,
@@ -55,4 +55,38 @@ namespace hypha
                 Content(NODE_LABEL, quantity.to_string() + " to " + recipient.to_string())}};
     }
 
+    ContentGroups Payer::batchReceipt(const eosio::name &recipient,
+                                      const AssetBatch &amounts,
+                                      const string &memo,
+                                      uint64_t dao_id)
+    {
+        ContentGroup details{
+            Content(CONTENT_GROUP_LABEL, DETAILS),
+            Content(RECIPIENT, recipient)
+        };
+
+        std::string label;
+
+        auto addAmount = [&](const std::string& item, const eosio::asset& amount) {
+            if (amount.is_valid() && amount.amount > 0) {
+                details.push_back(Content(item, amount));
+                label += (label.empty() ? "" : ", ") + amount.to_string();
+            }
+        };
+
+        addAmount(common::REWARD_AMOUNT, amounts.reward);
+        addAmount(common::PEG_AMOUNT, amounts.peg);
+        addAmount(common::VOICE_AMOUNT, amounts.voice);
+
+        details.push_back(Content(common::DAO.to_string(), static_cast<int64_t>(dao_id)));
+        details.push_back(Content(MEMO, memo));
+
+        return ContentGroups{
+            std::move(details),
+            ContentGroup{
+                Content(CONTENT_GROUP_LABEL, SYSTEM),
+                Content(TYPE, common::PAYMENT),
+                Content(NODE_LABEL, label + " to " + recipient.to_string())}};
+    }
+
 } // namespace hypha
\ No newline at end of file
@@ -10,7 +10,7 @@
 namespace hypha
 {
 
-    Payer *PayerFactory::Factory(dao &dao, Settings* daoSettings, const eosio::symbol &symbol, const eosio::name &paymentType, const AssetBatch& daoTokens)
+    std::unique_ptr<Payer> PayerFactory::Factory(dao &dao, Settings* daoSettings, const eosio::symbol &symbol, const eosio::name &paymentType, const AssetBatch& daoTokens)
     {
         TRACE_FUNCTION()
 
@@ -19,13 +19,13 @@ namespace hypha
                 daoSettings->getSettingOrDefault<int64_t>(common::CLAIM_ENABLED, 0) == 1,
                 "Cash payments are currently disabled"
             )
-            return new PegPayer(dao, daoSettings);
+            return std::make_unique<PegPayer>(dao, daoSettings);
         }
         else if (symbol.raw() == daoTokens.reward.symbol.raw()) {
-            return new RewardPayer(dao, daoSettings);
+            return std::make_unique<RewardPayer>(dao, daoSettings);
         }
         else if (symbol.raw() == daoTokens.voice.symbol.raw()) {
-            return new VoicePayer(dao, daoSettings);
+            return std::make_unique<VoicePayer>(dao, daoSettings);
         }
 
         EOS_CHECK(false, "Unknown - symbol: " + symbol.code().to_string() + " payment type: " + paymentType.to_string());
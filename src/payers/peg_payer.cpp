@@ -11,20 +11,16 @@
 namespace hypha
 {
 
-    Document PegPayer::payImpl(const eosio::name &recipient,
-                                 const eosio::asset &quantity,
-                                 const string &memo)
+    void PegPayer::payImpl(const eosio::name &recipient,
+                           const eosio::asset &quantity,
+                           const string &memo)
     {
         TRACE_FUNCTION()
-        issueToken(m_dao.getSettingOrFail<eosio::name>(PEG_TOKEN_CONTRACT),
-                   m_dao.getSettingOrFail<eosio::name>(TREASURY_CONTRACT),
+        issueToken(m_dao.getContractName(PEG_TOKEN_CONTRACT),
+                   m_dao.getContractName(TREASURY_CONTRACT),
                    recipient, 
                    quantity,
                    memo);
-
-        return Document(m_dao.get_self(),
-                        m_dao.get_self(),
-                        defaultReceipt(recipient, quantity, memo, m_daoSettings->getRootID()));
     }
 
 } // namespace hypha
\ No newline at end of file
@@ -14,14 +14,14 @@
 namespace hypha
 {
 
-    Document RewardPayer::payImpl(const eosio::name &recipient,
-                                 const eosio::asset &quantity,
-                                 const string &memo)
+    void RewardPayer::payImpl(const eosio::name &recipient,
+                              const eosio::asset &quantity,
+                              const string &memo)
     {
         TRACE_FUNCTION()
 
         if (m_daoSettings->getOrFail<name>(DAO_NAME) == eosio::name("hypha")) {
-            issueToken(m_dao.getSettingOrFail<eosio::name>(REWARD_TOKEN_CONTRACT),
+            issueToken(m_dao.getContractName(REWARD_TOKEN_CONTRACT),
                        m_dao.get_self(),
                        m_dao.getSettingOrFail<eosio::name>(HYPHA_COSALE_CONTRACT),
                        quantity,
@@ -38,16 +38,12 @@ namespace hypha
                 .send();
         }
         else {
-            issueToken(m_dao.getSettingOrFail<eosio::name>(REWARD_TOKEN_CONTRACT),
+            issueToken(m_dao.getContractName(REWARD_TOKEN_CONTRACT),
                        m_dao.get_self(),
                        recipient, 
                        quantity,
                        memo);
         }
-
-        return Document(m_dao.get_self(),
-                        m_dao.get_self(),
-                        defaultReceipt(recipient, quantity, memo, m_daoSettings->getRootID()));
     }
 
 } // namespace hypha
\ No newline at end of file
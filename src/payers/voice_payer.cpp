@@ -11,21 +11,17 @@
 namespace hypha
 {
 
-    Document VoicePayer::payImpl(const eosio::name &recipient,
-                                  const eosio::asset &quantity,
-                                  const string &memo)
+    void VoicePayer::payImpl(const eosio::name &recipient,
+                             const eosio::asset &quantity,
+                             const string &memo)
     {
         TRACE_FUNCTION()
-        issueTenantToken(m_dao.getSettingOrFail<eosio::name>(GOVERNANCE_TOKEN_CONTRACT),
+        issueTenantToken(m_dao.getContractName(GOVERNANCE_TOKEN_CONTRACT),
                          m_daoSettings->getOrFail<name>(DAO_NAME),
                          m_dao.get_self(),
                          recipient,
                          quantity,
                          memo);
-
-        return Document(m_dao.get_self(),
-                        m_dao.get_self(),
-                        defaultReceipt(recipient, quantity, memo, m_daoSettings->getRootID()));
     }
 
 } // namespace hypha
\ No newline at end of file
@@ -1,4 +1,7 @@
 #include <period.hpp>
+
+#include <iterator>
+
 #include <common.hpp>
 #include <util.hpp>
 #include <dao.hpp>
@@ -7,6 +10,71 @@
 
 namespace hypha
 {
+    using CalendarRow = dao::CalendarPeriod;
+
+    static std::optional<CalendarRow> getCalendarRow(dao *dao, uint64_t periodID)
+    {
+        dao::calendar_table calendar(dao->get_self(), dao->get_self().value);
+
+        if (auto it = calendar.find(periodID); it != calendar.end()) {
+            return *it;
+        }
+
+        return std::nullopt;
+    }
+
+    static std::optional<CalendarRow> getCalendarRowAt(dao *dao, uint64_t calendarID, uint64_t index)
+    {
+        dao::calendar_table calendar(dao->get_self(), dao->get_self().value);
+
+        auto byIndex = calendar.get_index<name("byindex")>();
+
+        if (auto it = byIndex.find(CalendarRow::build_key(calendarID, index)); it != byIndex.end()) {
+            return *it;
+        }
+
+        return std::nullopt;
+    }
+
+    //Calendars are fully indexed once their last period has a row
+    static bool isCalendarIndexed(dao *dao, uint64_t calendarID)
+    {
+        auto [hasEnd, endEdge] = Edge::getIfExists(dao->get_self(), calendarID, common::END);
+        return hasEnd && getCalendarRow(dao, endEdge.getToNode());
+    }
+
+    //Finds the first period of the calendar which ends at or after the given moment
+    static CalendarRow getCalendarRowFor(dao *dao, uint64_t calendarID, eosio::time_point moment)
+    {
+        dao::calendar_table calendar(dao->get_self(), dao->get_self().value);
+
+        auto byStart = calendar.get_index<name("bystart")>();
+
+        uint64_t momentSec = moment.sec_since_epoch();
+
+        //First period starting at or after the moment
+        auto it = byStart.lower_bound(CalendarRow::build_key(calendarID, momentSec));
+
+        if (it != byStart.begin()) {
+            auto prev = std::prev(it);
+            if (prev->calendar_id == calendarID) {
+                it = prev;
+            }
+        }
+
+        EOS_CHECK(
+            it != byStart.end() && it->calendar_id == calendarID && it->start_sec <= momentSec,
+            to_str("start_period is in the future. No period found. Moment: ", momentSec)
+        );
+
+        EOS_CHECK(
+            it->end_sec != 0,
+            "End of calendar has been reached. Contact administrator to add more time periods."
+        );
+
+        return *it;
+    }
+
     Period::Period(dao *dao,
                    const eosio::time_point &start_time,
                    const std::string &label)
@@ -78,6 +146,10 @@ namespace hypha
 
     eosio::time_point Period::getEndTime()
     {
+        if (auto row = getCalendarRow(m_dao, getID()); row && row->end_sec != 0) {
+            return eosio::time_point(eosio::seconds(row->end_sec));
+        }
+
         return next().getStartTime();
     }
 
@@ -97,12 +169,39 @@ namespace hypha
         return false;
     }
 
+    uint64_t Period::getCalendarID()
+    {
+        if (auto row = getCalendarRow(m_dao, getID())) {
+            return row->calendar_id;
+        }
+
+        return Edge::get(m_dao->get_self(), getID(), common::CALENDAR).getToNode();
+    }
+
     Period Period::asOf(dao *dao, uint64_t daoID, eosio::time_point moment)
     {
         TRACE_FUNCTION()
 
         auto [exists, startEdge] = Edge::getIfExists(dao->get_self(), daoID, common::CURRENT);
 
+        //Use the calendar index if the DAO calendar was already indexed
+        if (auto [hasCalendar, calendarEdge] = Edge::getIfExists(dao->get_self(), daoID, common::CALENDAR);
+            hasCalendar && isCalendarIndexed(dao, calendarEdge.getToNode())) {
+
+            auto row = getCalendarRowFor(dao, calendarEdge.getToNode(), moment);
+
+            //Only update the edge if the current period changed
+            if (!exists || startEdge.getToNode() != row.period_id) {
+                if (exists) {
+                    startEdge.erase();
+                }
+
+                Edge::write(dao->get_self(), dao->get_self(), daoID, row.period_id, common::CURRENT);
+            }
+
+            return Period(dao, row.period_id);
+        }
+
         //Delete the edge so we can update it to the new current period
         if (exists) {
             startEdge.erase();
@@ -161,6 +260,12 @@ namespace hypha
           "Count has to be greater or equal to 0"
         );
 
+        if (auto row = getCalendarRow(m_dao, id)) {
+            if (auto nth = getCalendarRowAt(m_dao, row->calendar_id, row->period_index + count)) {
+                return Period(m_dao, nth->period_id);
+            }
+        }
+
         int64_t nextID = id;
 
         while (count-- > 0)
@@ -182,6 +287,14 @@ namespace hypha
     int64_t Period::getPeriodCountTo(Period& other)
     {
       TRACE_FUNCTION()
+
+      if (auto row = getCalendarRow(m_dao, getID())) {
+        if (auto otherRow = getCalendarRow(m_dao, other.getID());
+            otherRow && otherRow->calendar_id == row->calendar_id) {
+          return static_cast<int64_t>(otherRow->period_index) - static_cast<int64_t>(row->period_index);
+        }
+      }
+
       auto otherStartSec = other.getStartTime().sec_since_epoch();
       auto currentStartSec = getStartTime().sec_since_epoch();
 
@@ -216,6 +329,12 @@ namespace hypha
                 moment.sec_since_epoch(), " [period]:", getID ())
       );
 
+      if (auto row = getCalendarRow(m_dao, getID());
+          row && isCalendarIndexed(m_dao, row->calendar_id)) {
+        auto until = getCalendarRowFor(m_dao, row->calendar_id, moment);
+        return until.period_index > row->period_index ? Period(m_dao, until.period_id) : next;
+      }
+
       while (moment > next.getEndTime()) {
         auto [hasNext, edge] = Edge::getIfExists(m_dao->get_self(), next.getID (), common::NEXT);
 
@@ -226,4 +345,36 @@ namespace hypha
 
       return next;
     }
+
+    void Period::appendToCalendar(dao *dao, uint64_t calendarID, std::optional<uint64_t> prevPeriodID, Period& period)
+    {
+        TRACE_FUNCTION()
+        dao::calendar_table calendar(dao->get_self(), dao->get_self().value);
+
+        uint32_t startSec = period.getStartTime().sec_since_epoch();
+        uint64_t index = 0;
+
+        if (prevPeriodID) {
+            auto prevIt = calendar.find(*prevPeriodID);
+
+            //Calendar hasn't been indexed yet
+            if (prevIt == calendar.end()) {
+                return;
+            }
+
+            calendar.modify(prevIt, dao->get_self(), [&](CalendarRow& row) {
+                row.end_sec = startSec;
+            });
+
+            index = prevIt->period_index + 1;
+        }
+
+        calendar.emplace(dao->get_self(), [&](CalendarRow& row) {
+            row.period_id = period.getID();
+            row.calendar_id = calendarID;
+            row.period_index = index;
+            row.start_sec = startSec;
+            row.end_sec = 0;
+        });
+    }
 } // namespace hypha
\ No newline at end of file
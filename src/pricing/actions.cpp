@@ -1,4 +1,5 @@
 #include <dao.hpp>
+#include <fixed_point.hpp>
 
 //#include <algorithm>
 //#include <time.h>
@@ -126,6 +127,8 @@ void dao::setEcosystemPlan(PlanManager& planManager)
     planManager.setCurrentBill(defBill);
     planManager.setLastBill(defBill);
     planManager.setStartBill(defBill);
+
+    planManager.updatePlanCache();
 }
 
 static void scheduleBillUpdate(const BillingInfo& bill, uint64_t daoID)
@@ -156,8 +159,6 @@ static void scheduleBillUpdate(const BillingInfo& bill, uint64_t daoID)
 
 static eosio::asset calculateHyphaAmount(dao& dao, const eosio::asset& usdAmount) {
     
-    auto normalized = normalizeToken(usdAmount);
-
     EOS_CHECK(
         usdAmount.symbol == hypha::common::S_USD,
         to_str("Symbol missmatch, expected USD, got", usdAmount)
@@ -171,9 +172,13 @@ static eosio::asset calculateHyphaAmount(dao& dao, const eosio::asset& usdAmount
         to_str("Expected sale_hypha_usd_value precision to be 4, but got:", saleHyphaUsdVal.symbol.precision())
     );
 
-    normalized /= normalizeToken(saleHyphaUsdVal);
-
-    return denormalizeToken(normalized, {0, hypha::common::S_HYPHA});
+    //HYPHA = USD / sale value, where the sale value has 4 decimals
+    return fixed::convert(
+        usdAmount,
+        hypha::common::S_HYPHA,
+        fixed::pow10(saleHyphaUsdVal.symbol.precision()),
+        saleHyphaUsdVal.amount
+    );
 }
 
 void dao::verifyEcosystemPayment(PlanManager& planManager, const string& priceItem, const string& priceStakedItem, const std::string& stakingMemo, const name& beneficiary)
@@ -516,15 +521,17 @@ ACTION dao::activateplan(ContentGroups& plan_info)
         to_str("Period amount must be greater or equal to ", offer.getPeriodCount())
     )
 
-    float offerDisc = 1.0f - offer.getDiscountPercentage() / 10000.f;
-
-    float priceDisc = 1.0f - plan.getDiscountPercentage() / 10000.f;
+    //Discounts are in base 10000
+    const int64_t DISCOUNT_BASE = 10000;
 
-    auto payAmount = calculateHyphaAmount(
-        *this, 
-        adjustAsset(plan.getPrice(), priceDisc * offerDisc * periods)
+    auto discountedPrice = adjustAsset(
+        plan.getPrice(),
+        (DISCOUNT_BASE - plan.getDiscountPercentage()) * (DISCOUNT_BASE - offer.getDiscountPercentage()) * periods,
+        DISCOUNT_BASE * DISCOUNT_BASE
     );
 
+    auto payAmount = calculateHyphaAmount(*this, discountedPrice);
+
     planManager.removeCredit(payAmount);
 
     planManager.update();
@@ -563,6 +570,8 @@ ACTION dao::activateplan(ContentGroups& plan_info)
         }
     }
 
+    planManager.updatePlanCache();
+
     if (!bill.getIsInfinite()) {
         scheduleBillUpdate(bill, daoID);
     }
@@ -733,6 +742,8 @@ ACTION dao::activatedao(eosio::name dao_name)
     planManager.setCurrentBill(defBill);
     planManager.setLastBill(defBill);
     planManager.setStartBill(defBill);
+
+    planManager.updatePlanCache();
 }
 
 ACTION dao::updateprcpln(uint64_t pricing_plan_id, ContentGroups& pricing_plan_info)
@@ -756,6 +767,19 @@ ACTION dao::updateprcpln(uint64_t pricing_plan_id, ContentGroups& pricing_plan_i
         .max_member_count = maxMembers ? maxMembers->getAs<int64_t>() : plan.getMaxMemberCount(),
         .discount_perc_x10000 = discount ? discount->getAs<int64_t>() : plan.getDiscountPercentage()
     });
+
+    if (maxMembers) {
+        //Keep the cached plan of the DAOs using this plan in sync
+        dao_plan_table plans(get_self(), get_self().value);
+
+        auto byPlan = plans.get_index<name("byplan")>();
+
+        for (auto it = byPlan.find(pricing_plan_id); it != byPlan.end() && it->plan_id == pricing_plan_id; ++it) {
+            byPlan.modify(it, get_self(), [&](DaoPlan& row) {
+                row.max_members = plan.getMaxMemberCount();
+            });
+        }
+    }
 }
 
 ACTION dao::updateprcoff(uint64_t price_offer_id, ContentGroups& price_offer_info)
@@ -784,6 +808,11 @@ ACTION dao::updatecurbil(uint64_t dao_id)
     //Prob it doens't require special perms
     checkAdminsAuth(dao_id);
 
+    //Nothing changed while the cached plan is still in effect
+    if (PlanManager::getCachedMaxMembers(*this, dao_id)) {
+        return;
+    }
+
     auto planManager = PlanManager::getFromDaoID(*this, dao_id);
 
     auto currentBill = planManager.getCurrentBill();
@@ -812,6 +841,7 @@ ACTION dao::updatecurbil(uint64_t dao_id)
                     now < bill->getEndDate() ||
                     (now < bill->getExpirationDate() && !next)) {
                     planManager.setCurrentBill(*bill);
+                    planManager.updatePlanCache();
                     auto updatedPlan = bill->getPricingPlan();
                     if (currentBill.getPricingPlan().getId() != updatedPlan.getId()) {
                         onDaoPlanChange(*this, dao_id, updatedPlan);
@@ -853,6 +883,15 @@ ACTION dao::updatecurbil(uint64_t dao_id)
             //Else do nothing and wait till the bill expires
         }
     }
+
+    planManager.updatePlanCache();
+}
+
+ACTION dao::trimmembers(uint64_t dao_id)
+{
+    eosio::require_auth(get_self());
+
+    trimMembers(*this, dao_id);
 }
 
 #endif
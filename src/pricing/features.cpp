@@ -8,53 +8,70 @@
 #include <document_graph/edge.hpp>
 
 #include "member.hpp"
+#include "badges/badges.hpp"
+
+#include <treasury/treasury.hpp>
+#include <treasury/common.hpp>
 
 namespace hypha::pricing
 {
 
 #ifdef USE_PRICING_PLAN
 
-static 
-PricingPlan getCurrentPlan(PlanManager& planManager)
+void checkDaoCanEnrrollMember(dao& dao, uint64_t daoID)
 {
-    auto currentBill = planManager.getCurrentBill();
+    auto maxMembers = PlanManager::getCachedMaxMembers(dao, daoID);
 
-    auto bill = std::make_unique<BillingInfo>(planManager.getDao(), currentBill.getId());
+    if (!maxMembers) {
+        if (auto planManager = PlanManager::getFromDaoIfExists(dao, daoID)) {
+            maxMembers = planManager->resolveCurrentPlan().first.getMaxMemberCount();
+        }
+    }
 
-    auto now = eosio::current_time_point();
+    //For DAO's without Plan Manager we assume there is no limit
+    if (maxMembers) 
+    {
+        auto currentMembers = Member::getMemberCount(dao, daoID, membership::CORE);
 
-    while (bill) {
-        auto next = bill->getNextBill();
-        if (bill->getIsInfinite() ||
-            now < bill->getEndDate() ||
-            (now < bill->getExpirationDate() && !next)) {
-            return bill->getPricingPlan();
+        if (!currentMembers) {
+            currentMembers = Edge::getEdgesFromCount(dao.get_self(), daoID, common::MEMBER);
         }
-        bill = std::move(next);
-    }
 
-    return PlanManager::getDefaultPlan(planManager.getDao());
+        EOS_CHECK(
+            *currentMembers < *maxMembers,
+            to_str("You already reached the max number of members available for your plan: ", *maxMembers)
+        )
+    }
 }
 
-void checkDaoCanEnrrollMember(dao& dao, uint64_t daoID)
+//Cursor value used to start visiting members from the most recent one
+static constexpr uint128_t TRIM_FROM_NEWEST = ~static_cast<uint128_t>(0);
+
+static void removeMember(dao& dao, uint64_t daoID, Member& mem)
 {
-    if (auto planManager = PlanManager::getFromDaoIfExists(dao, daoID)) 
+    //If it's admin or enroller let's remove those perms as well
+    if (Edge::exists(dao.get_self(), daoID, mem.getID(), common::ADMIN))
     {
-        auto currentPlan = getCurrentPlan(*planManager);
-
-        auto currentMembers = Edge::getEdgesFromCount(dao.get_self(), daoID, common::MEMBER);
+        Edge::get(dao.get_self(), daoID, mem.getID(), common::ADMIN).erase();
+#ifdef USE_TREASURY
+        treasury::Treasury::setAuthRole(dao, daoID, mem.getAccount(), treasury::common::auth_roles::ADMIN, false);
+#endif
+        badges::setSystemBadge(dao, daoID, mem.getID(), badges::SystemBadgeType::Admin, false);
+    }
 
-        EOS_CHECK(
-            currentMembers < currentPlan.getMaxMemberCount(),
-            to_str("You already reached the max number of members available for your plan: ", currentPlan.getMaxMemberCount())
-        )
+    if (Edge::exists(dao.get_self(), daoID, mem.getID(), common::ENROLLER))
+    {
+        Edge::get(dao.get_self(), daoID, mem.getID(), common::ENROLLER).erase();
+        badges::setSystemBadge(dao, daoID, mem.getID(), badges::SystemBadgeType::Enroller, false);
     }
-    //For DAO's without Plan Manager we assume there is no limit
+
+    mem.removeMembershipFromDao(daoID);
+    mem.apply(daoID, "Auto apply after being removed");
 }
 
-void onDaoPlanChange(dao& dao, uint64_t daoID, PricingPlan& newPlan)
+//Used for DAOs whose membership table isn't indexed yet
+static void trimMembersFromEdges(dao& dao, uint64_t daoID, PricingPlan& newPlan)
 {
-    //Check if we need to remove users
     auto membersEdges = dao.getGraph().getEdgesFrom(daoID, common::MEMBER);
 
     if (membersEdges.size() > newPlan.getMaxMemberCount()) {
@@ -85,23 +102,124 @@ void onDaoPlanChange(dao& dao, uint64_t daoID, PricingPlan& newPlan)
         while (memEdgeIt != membersEdges.end()) {
             Member mem(dao, memEdgeIt->to_node);
 
-            //If it's admin or enroller let's remove those perms as well
-            if (Edge::exists(dao.get_self(), daoID, mem.getID(), common::ADMIN))
-            {
-                Edge::get(dao.get_self(), daoID, mem.getID(), common::ADMIN).erase();
-            }
+            removeMember(dao, daoID, mem);
 
-            if (Edge::exists(dao.get_self(), daoID, mem.getID(), common::ENROLLER))
-            {
-                Edge::get(dao.get_self(), daoID, mem.getID(), common::ENROLLER).erase();
+            ++memEdgeIt;
+        }
+    }
+}
+
+static void scheduleTrimMembers(dao& dao, uint64_t daoID)
+{
+    eosio::action act(
+        eosio::permission_level(dao.get_self(), eosio::name("active")),
+        dao.get_self(),
+        eosio::name("trimmembers"),
+        std::make_tuple(daoID)
+    );
+
+    dao.schedule_deferred_action(eosio::time_point_sec(eosio::current_time_point()), act);
+}
+
+void onDaoPlanChange(dao& dao, uint64_t daoID, PricingPlan& newPlan)
+{
+    auto memberCount = Member::getMemberCount(dao, daoID, membership::CORE);
+
+    if (!memberCount) {
+        trimMembersFromEdges(dao, daoID, newPlan);
+        return;
+    }
+
+    dao::member_trim_job_table jobs(dao.get_self(), dao.get_self().value);
+
+    auto jobIt = jobs.find(daoID);
+
+    auto maxMembers = static_cast<uint64_t>(newPlan.getMaxMemberCount());
+
+    if (*memberCount <= maxMembers) {
+        //A previous downgrade might still be pending
+        if (jobIt != jobs.end()) {
+            jobs.erase(jobIt);
+        }
+        return;
+    }
+
+    auto resetJob = [&](dao::MemberTrimJob& job) {
+        job.dao_id = daoID;
+        job.remaining = *memberCount - maxMembers;
+        job.cursor = TRIM_FROM_NEWEST;
+        job.admins = false;
+    };
+
+    if (jobIt == jobs.end()) {
+        jobs.emplace(dao.get_self(), resetJob);
+    }
+    else {
+        jobs.modify(jobIt, dao.get_self(), resetJob);
+    }
+
+    trimMembers(dao, daoID);
+}
+
+void trimMembers(dao& dao, uint64_t daoID)
+{
+    //Max number of members visited on each run
+    const size_t MAX_VISITED_PER_ACTION = 50;
+
+    dao::member_trim_job_table jobs(dao.get_self(), dao.get_self().value);
+
+    auto jobIt = jobs.find(daoID);
+
+    if (jobIt == jobs.end()) {
+        return;
+    }
+
+    auto job = *jobIt;
+
+    dao::core_member_table coreMembers(dao.get_self(), daoID);
+
+    auto byJoined = coreMembers.get_index<name("byjoined")>();
+
+    for (size_t visited = 0; visited < MAX_VISITED_PER_ACTION && job.remaining > 0; ++visited) {
+        
+        //Removed members are erased from the index, so look up the position again on each step
+        auto it = byJoined.lower_bound(job.cursor);
+
+        if (it == byJoined.begin()) {
+            //Only remove admins once there are no regular members left
+            if (job.admins) {
+                break;
             }
 
-            mem.removeMembershipFromDao(daoID);
-            mem.apply(daoID, "Auto apply after being removed");
+            job.admins = true;
+            job.cursor = TRIM_FROM_NEWEST;
+            continue;
+        }
+
+        --it;
 
-            ++memEdgeIt;
+        job.cursor = it->by_joined();
+
+        if (Edge::exists(dao.get_self(), daoID, it->member_id, common::ADMIN) == job.admins) {
+            Member mem(dao, it->member_id);
+            removeMember(dao, daoID, mem);
+            --job.remaining;
         }
     }
+
+    bool pending = job.remaining > 0 && 
+                   !(job.admins && byJoined.lower_bound(job.cursor) == byJoined.begin());
+
+    if (pending) {
+        jobs.modify(jobIt, dao.get_self(), [&](dao::MemberTrimJob& row) {
+            row = job;
+        });
+
+        scheduleTrimMembers(dao, daoID);
+    }
+    else {
+        jobs.erase(jobIt);
+    }
 }
 
 #endif
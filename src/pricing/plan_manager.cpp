@@ -222,7 +222,8 @@ eosio::asset PlanManager::calculateCredit()
 
         auto amount = adjustAsset(
             next->getTotalPaid(),
-            std::min(1.0f, float(remaining) / float(total))
+            std::min(remaining, total),
+            total
         );
 
         EOS_CHECK(
@@ -238,6 +239,66 @@ eosio::asset PlanManager::calculateCredit()
     return credit;
 }
 
+std::pair<PricingPlan, eosio::time_point> PlanManager::resolveCurrentPlan()
+{
+    auto bill = std::make_unique<BillingInfo>(getDao(), getCurrentBill().getId());
+
+    auto now = eosio::current_time_point();
+
+    while (bill) {
+        auto next = bill->getNextBill();
+        if (bill->getIsInfinite()) {
+            return { bill->getPricingPlan(), eosio::time_point::maximum() };
+        }
+        else if (now < bill->getEndDate() && next) {
+            return { bill->getPricingPlan(), bill->getEndDate() };
+        }
+        //The last bill stays in effect during the grace period
+        else if (now < bill->getExpirationDate() && !next) {
+            return { bill->getPricingPlan(), bill->getExpirationDate() };
+        }
+        bill = std::move(next);
+    }
+
+    //Default plan stays until a new plan is activated
+    return { getDefaultPlan(getDao()), eosio::time_point::maximum() };
+}
+
+void PlanManager::updatePlanCache()
+{
+    auto daoID = Edge::getTo(getDao().get_self(), getId(), links::PLAN_MANAGER).getFromNode();
+
+    auto currentPlan = resolveCurrentPlan();
+
+    dao::dao_plan_table plans(getDao().get_self(), getDao().get_self().value);
+
+    auto update = [&](dao::DaoPlan& row) {
+        row.dao_id = daoID;
+        row.plan_id = currentPlan.first.getId();
+        row.max_members = currentPlan.first.getMaxMemberCount();
+        row.valid_until = currentPlan.second;
+    };
+
+    if (auto it = plans.find(daoID); it != plans.end()) {
+        plans.modify(it, getDao().get_self(), update);
+    }
+    else {
+        plans.emplace(getDao().get_self(), update);
+    }
+}
+
+std::optional<int64_t> PlanManager::getCachedMaxMembers(dao& dao, uint64_t daoID)
+{
+    dao::dao_plan_table plans(dao.get_self(), dao.get_self().value);
+
+    if (auto it = plans.find(daoID); 
+        it != plans.end() && eosio::current_time_point() < it->valid_until) {
+        return it->max_members;
+    }
+
+    return std::nullopt;
+}
+
 bool PlanManager::hasBills()
 {
     return !getDao()
@@ -11,6 +11,7 @@
 #include <proposals/edit_proposal.hpp>
 #include <proposals/ass_extend_proposal.hpp>
 #include <assignment.hpp>
+#include <time_share.hpp>
 
 namespace hypha
 {
@@ -112,6 +113,10 @@ namespace hypha
         // erase the original document
         m_dao.getGraph().eraseDocument(original.getID(), true);
 
+        //The merged document has a new id, so the cursor and timeline of the original can't be reused
+        Assignment::eraseClaimCursor(m_dao, original.getID());
+        TimeShare::eraseTimeline(m_dao.get_self(), original.getID());
+
         //Restore groups
         proposalContent.getContentGroups() = std::move(originalContents);
     }
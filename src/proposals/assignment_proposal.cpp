@@ -126,7 +126,7 @@ namespace hypha
             //     "Only future periods are allowed for starting period"
             // )
 
-            auto calendarId = Edge::get(m_dao.get_self(), period.getID(), common::CALENDAR).getToNode();
+            auto calendarId = Period(&m_dao, period.getID()).getCalendarID();
 
             //TODO Period: Remove since period refactor will no longer point to DAO
             EOS_CHECK(
@@ -159,7 +159,11 @@ namespace hypha
         }
 
         // add the USD period pay amount (this is used to calculate SEEDS at time of salary claim)
-        Content usdSalaryPerPeriod(USD_SALARY_PER_PERIOD, adjustAsset(annual_usd_salary, getPhaseToYearRatio(m_daoSettings)));
+        Content usdSalaryPerPeriod(USD_SALARY_PER_PERIOD, adjustAsset(
+            annual_usd_salary,
+            m_daoSettings->getOrFail<int64_t>(common::PERIOD_DURATION),
+            common::YEAR_DURATION_SEC
+        ));
         ContentWrapper::insertOrReplace(*detailsGroup, usdSalaryPerPeriod);
 
         //TODO: Normalize all the tokens to allow different precisions on each token
@@ -172,11 +176,12 @@ namespace hypha
         };
 
         SalaryConfig salaryConf {
-            .periodSalary = normalizeToken(usdSalaryPerPeriod.getAs<asset>()) * (timeShare / 100.0),
-            .deferredPerc = deferred / 100.0,
-            .voiceMultipler = getMultiplier(m_daoSettings, common::VOICE_MULTIPLIER, 1.0),
-            .rewardMultipler = getMultiplier(m_daoSettings, common::REWARD_MULTIPLIER, 1.0),
-            .pegMultipler = getMultiplier(m_daoSettings, common::PEG_MULTIPLIER, 1.0)
+            .periodSalary = usdSalaryPerPeriod.getAs<asset>(),
+            .timeShare = timeShare,
+            .deferredPerc = deferred,
+            .voiceMultipler = getMultiplier(m_daoSettings, common::VOICE_MULTIPLIER, 100),
+            .rewardMultipler = getMultiplier(m_daoSettings, common::REWARD_MULTIPLIER, 100),
+            .pegMultipler = getMultiplier(m_daoSettings, common::PEG_MULTIPLIER, 100)
         };
 
         AssetBatch salaries = calculateSalaries(salaryConf, tokens);
@@ -272,6 +277,8 @@ namespace hypha
         Edge::write(m_dao.get_self(), m_dao.get_self(), proposal.getID (), initTimeShareDoc.getID (), common::LAST_TIME_SHARE);
         Edge::write(m_dao.get_self(), m_dao.get_self(), proposal.getID (), initTimeShareDoc.getID (), common::TIME_SHARE_LABEL);
 
+        initTimeShareDoc.addToTimeline(proposal.getID());
+
         auto [detailsIdx, details] = contentWrapper.getGroup(DETAILS);
 
         contentWrapper.insertOrReplace(*details, Content{
@@ -5,6 +5,7 @@
 #include <proposals/badge_assignment_proposal.hpp>
 #include <common.hpp>
 #include <member.hpp>
+#include <period.hpp>
 #include <logger/logger.hpp>
 
 #include <badges/badges.hpp>
@@ -202,7 +203,7 @@ namespace hypha
                 common::PERIOD
             );
             
-            auto calendarId = Edge::get(m_dao.get_self(), period.getID(), common::CALENDAR).getToNode();
+            auto calendarId = Period(&m_dao, period.getID()).getCalendarID();
 
             //TODO Period: Remove since period refactor will no longer point to DAO
             EOS_CHECK(
@@ -39,11 +39,11 @@ void PayoutProposal::checkTokenItems(Settings* daoSettings, ContentWrapper conte
         EOS_CHECK(deferred <= 100, DEFERRED + string(" must be less than or equal to 100 (=100%). You submitted: ") + std::to_string(deferred));
         
         auto salaries = calculateSalaries(SalaryConfig {
-            .periodSalary = normalizeToken(usd),
-            .deferredPerc = deferred / 100.0,
-            .voiceMultipler = getMultiplier(daoSettings, common::VOICE_MULTIPLIER, 1.0),
-            .rewardMultipler = getMultiplier(daoSettings, common::REWARD_MULTIPLIER, 1.0),
-            .pegMultipler = getMultiplier(daoSettings, common::PEG_MULTIPLIER, 1.0)
+            .periodSalary = usd,
+            .deferredPerc = deferred,
+            .voiceMultipler = getMultiplier(daoSettings, common::VOICE_MULTIPLIER, 100),
+            .rewardMultipler = getMultiplier(daoSettings, common::REWARD_MULTIPLIER, 100),
+            .pegMultipler = getMultiplier(daoSettings, common::PEG_MULTIPLIER, 100)
         }, tokens);
 
         ContentWrapper::insertOrReplace(*detailsGroup, Content{ common::VOICE_AMOUNT, salaries.voice });
@@ -171,7 +171,7 @@ void PayoutProposal::passImpl(Document &proposal)
     // Graph updates:
     //  dao     ---- payout ---->   payout
     //  member  ---- payout ---->   payout
-    //  makePayment also creates edges from payout and the member to the individual payments
+    //  makePayments also creates edges from payout and the member to the payment receipt
     Edge::write(m_dao.get_self(), m_dao.get_self(), m_daoID, proposal.getID(), common::PAYOUT);
 
     auto cw = proposal.getContentWrapper();
@@ -208,15 +208,22 @@ void PayoutProposal::pay(Document &proposal, eosio::name edgeName)
     if (tokens.peg.is_valid()) payoutItems.push_back(common::PEG_AMOUNT);
     if (tokens.reward.is_valid()) payoutItems.push_back(common::REWARD_AMOUNT);
 
+    AssetBatch amounts;
+
     for (Content &content : *detailsGroup)
     {
         if (auto it = std::find(payoutItems.begin(), payoutItems.end(), content.label);
             it != payoutItems.end())
         {
-            m_dao.makePayment(m_daoSettings, proposal.getID(), recipient, std::get<eosio::asset>(content.value), memo, eosio::name{0}, tokens);
+            auto& amount = content.label == common::VOICE_AMOUNT ? amounts.voice :
+                           content.label == common::PEG_AMOUNT ? amounts.peg : amounts.reward;
+
+            amount = std::get<eosio::asset>(content.value);
             payoutItems.erase(it);
         }
     }
+
+    m_dao.makePayments(m_daoSettings, proposal.getID(), recipient, amounts, memo, eosio::name{0}, tokens);
 }
 
 std::string PayoutProposal::getBallotContent(ContentWrapper &contentWrapper)
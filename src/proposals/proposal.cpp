@@ -12,6 +12,7 @@
 #include <dao.hpp>
 #include <voice/currency_stats.hpp>
 #include <util.hpp>
+#include <fixed_point.hpp>
 #include <logger/logger.hpp>
 #include <recurring_activity.hpp>
 #include <comments/section.hpp>
@@ -154,9 +155,19 @@ namespace hypha
         );
 
         //TODO: Add parameter to check voting type (community or core)
-        Vote(m_dao, voter, vote, proposal, notes);
-        
-        VoteTally(m_dao, proposal, m_daoSettings);
+        Vote newVote(m_dao, voter, vote, proposal, notes);
+
+        //Only apply the delta of this vote instead of re-tallying every vote
+        if (auto [exists, tallyEdge] = Edge::getIfExists(m_dao.get_self(), proposal.getID(), common::VOTE_TALLY);
+            exists) {
+            VoteTally tally(m_dao, tallyEdge.getToNode());
+            tally.updateVote(newVote.getPreviousVote(), vote, newVote.getPower());
+
+            VoteTally::updateBallot(m_dao, proposal.getID(), newVote.getPreviousVote(), vote, newVote.getPower());
+        }
+        else {
+            VoteTally(m_dao, proposal, m_daoSettings);
+        }
     }
 
     void Proposal::internalClose(Document &proposal, bool pass)
@@ -168,28 +179,38 @@ namespace hypha
           pass ? common::STATE_APPROVED : common::STATE_REJECTED
         });
 
+        dao::ballot_table ballots(m_dao.get_self(), m_dao.get_self().value);
+
+        auto ballotIt = ballots.find(proposal.getID());
+
         //Since getting supply might be a heavy computaion we store it in other places, so if that's the case
         //don't calculate it again
         if (!proposal.getContentWrapper().exists(DETAILS, common::BALLOT_SUPPLY)) {
             ContentWrapper::insertOrReplace(*details, Content {
                 common::BALLOT_SUPPLY,
-                getVoiceSupply(proposal)
+                ballotIt != ballots.end() ? ballotIt->supply : getVoiceSupply(proposal)
             });
         }
 
         ContentWrapper::insertOrReplace(*details, Content {
             common::BALLOT_QUORUM,
-            m_daoSettings->getOrFail<int64_t>(VOTING_QUORUM_FACTOR_X100)
+            m_daoSettings->getQuorumFactor()
         });
 
         ContentWrapper::insertOrReplace(*details, Content {
             common::BALLOT_ALIGNMENT,
-            m_daoSettings->getOrFail<int64_t>(VOTING_ALIGNMENT_FACTOR_X100)
+            m_daoSettings->getAlignmentFactor()
         });
 
         Edge edge = Edge::get(m_dao.get_self(), m_daoID, proposal.getID (), common::PROPOSAL);
         edge.erase();
 
+        if (ballotIt != ballots.end()) {
+            ballots.erase(ballotIt);
+        }
+
+        Vote::eraseVotes(m_dao, proposal.getID());
+
         if (pass)
         {
             auto system = proposal.getContentWrapper().getGroupOrFail(SYSTEM);
@@ -233,14 +254,40 @@ namespace hypha
             "Only published proposals can be closed"
         );
 
-        auto voteTallyEdge = Edge::get(m_dao.get_self(), proposal.getID (), common::VOTE_TALLY);
-
         auto expiration = proposal.getContentWrapper().getOrFail(BALLOT, EXPIRATION_LABEL, "Proposal has no expiration")->getAs<eosio::time_point>();
         EOS_CHECK(
             eosio::time_point_sec(eosio::current_time_point()) > expiration,
             "Voting is still active for this proposal"
         );
 
+        dao::ballot_table ballots(m_dao.get_self(), m_dao.get_self().value);
+
+        //Proposals published with a ballot row can be closed from it alone
+        if (auto ballotIt = ballots.find(proposal.getID()); ballotIt != ballots.end()) {
+            auto voiceSupply = ballotIt->supply;
+
+            //DAOs using live voice power check quorum against the current supply
+            if (m_daoSettings->getSettingOrDefault<int64_t>(common::VOICE_SNAPSHOT, 0) == 0) {
+                voiceSupply = getVoiceSupply(proposal);
+
+                ContentWrapper::insertOrReplace(
+                    *proposal.getContentWrapper().getGroupOrFail(DETAILS),
+                    Content { common::BALLOT_SUPPLY, voiceSupply }
+                );
+            }
+
+            //Currently if 2 North Start badge holders veto the proposal
+            //it should not pass
+            bool proposalDidPass = ballotIt->vetoes < 2 && 
+                                   didPass(voiceSupply, ballotIt->pass, ballotIt->abstain, ballotIt->fail);
+
+            internalClose(proposal, proposalDidPass);
+
+            return;
+        }
+
+        auto voteTallyEdge = Edge::get(m_dao.get_self(), proposal.getID (), common::VOTE_TALLY);
+
         bool proposalDidPass;
 
         auto vetoByEdges = m_dao.getGraph()
@@ -298,6 +345,8 @@ namespace hypha
         Section commentSection(m_dao, Edge::get(m_dao.get_self(), proposal.getID(), common::COMMENT_SECTION).getToNode());
         commentSection.remove();
 
+        Vote::eraseVotes(m_dao, proposal.getID());
+
         m_dao.getGraph().eraseDocument(proposal.getID(), true);
     }
 
@@ -363,24 +412,6 @@ namespace hypha
     {
         TRACE_FUNCTION()
 
-        int64_t quorumFactor = m_daoSettings->getOrFail<int64_t>(VOTING_QUORUM_FACTOR_X100);
-        int64_t alignmentFactor = m_daoSettings->getOrFail<int64_t>(VOTING_ALIGNMENT_FACTOR_X100);
-
-        //quorumFactor = std::max(0.00f, std::min(1.00f, quorumFactor));
-        //alignmentFactor = std::max(0.00f, std::min(1.00f, alignmentFactor));
-
-        const int64_t maxFactor = 100;
-
-        EOS_CHECK(
-            quorumFactor >= 0 && quorumFactor <= maxFactor,
-            to_str("Quorum Factor out of valid range", quorumFactor)
-        );
-
-        EOS_CHECK(
-            alignmentFactor >= 0 && alignmentFactor <= maxFactor,
-            to_str("Alginment Factor out of valid range", alignmentFactor)
-        );
-
         asset voiceSupply;
 
         voiceSupply = getVoiceSupply(proposal);
@@ -394,8 +425,6 @@ namespace hypha
                 voiceSupply
             }
         );
-        
-        asset quorum_threshold = voiceSupply * quorumFactor;
 
         VoteTally tally(m_dao, tallyID);
 
@@ -407,6 +436,34 @@ namespace hypha
         asset votes_abstain = tally.getDocument().getContentWrapper().getOrFail(common::BALLOT_DEFAULT_OPTION_ABSTAIN.to_string(), VOTE_POWER)->getAs<eosio::asset>();
         asset votes_fail = tally.getDocument().getContentWrapper().getOrFail(common::BALLOT_DEFAULT_OPTION_FAIL.to_string(), VOTE_POWER)->getAs<eosio::asset>();
 
+        return didPass(voiceSupply, votes_pass, votes_abstain, votes_fail);
+    }
+
+    bool Proposal::didPass(const asset& voiceSupply,
+                           const asset& votes_pass,
+                           const asset& votes_abstain,
+                           const asset& votes_fail)
+    {
+        int64_t quorumFactor = m_daoSettings->getQuorumFactor();
+        int64_t alignmentFactor = m_daoSettings->getAlignmentFactor();
+
+        //quorumFactor = std::max(0.00f, std::min(1.00f, quorumFactor));
+        //alignmentFactor = std::max(0.00f, std::min(1.00f, alignmentFactor));
+
+        const int64_t maxFactor = 100;
+
+        EOS_CHECK(
+            quorumFactor >= 0 && quorumFactor <= maxFactor,
+            to_str("Quorum Factor out of valid range", quorumFactor)
+        );
+
+        EOS_CHECK(
+            alignmentFactor >= 0 && alignmentFactor <= maxFactor,
+            to_str("Alginment Factor out of valid range", alignmentFactor)
+        );
+        
+        asset quorum_threshold = voiceSupply * quorumFactor;
+
         asset total = votes_pass + votes_abstain + votes_fail;
 
         // pass / ( pass + fail ) > alignmentFactor
@@ -470,24 +527,28 @@ namespace hypha
 
     eosio::asset Proposal::getVoiceSupply(Document& proposal)
     {
-        asset voiceToken = m_daoSettings->getOrFail<eosio::asset>(common::VOICE_TOKEN);
+        asset voiceToken = m_daoSettings->getVoiceToken();
 
         //If community voting is enabled supply should be equal to amount of members (both community and core)
         if (auto [_, communityVote] = proposal.getContentWrapper().get(SYSTEM, common::COMMUNITY_VOTING);
             communityVote && communityVote->getAs<int64_t>()) {
             
             //Get total amount of members and community members
-            auto totalMembers = Edge::getEdgesFromCount(m_dao.get_self(), m_daoID, common::MEMBER);
-            totalMembers += Edge::getEdgesFromCount(m_dao.get_self(), m_daoID, common::COMMEMBER);
+            auto totalMembers = Member::getMemberCount(m_dao, m_daoID, membership::CORE | membership::COMMUNITY);
+
+            if (!totalMembers) {
+                totalMembers = Edge::getEdgesFromCount(m_dao.get_self(), m_daoID, common::MEMBER) +
+                               Edge::getEdgesFromCount(m_dao.get_self(), m_daoID, common::COMMEMBER);
+            }
             
-            return denormalizeToken(static_cast<double>(totalMembers), voiceToken);
+            return fixed::units(*totalMembers, voiceToken.symbol);
         }
 
-        name voiceContract = m_dhoSettings->getOrFail<eosio::name>(GOVERNANCE_TOKEN_CONTRACT);
+        name voiceContract = m_dao.getContractName(GOVERNANCE_TOKEN_CONTRACT);
         hypha::voice::stats statstable(voiceContract, voiceToken.symbol.code().raw());
         auto stats_index = statstable.get_index<name("bykey")>();
 
-        auto daoName = m_daoSettings->getOrFail<name>(DAO_NAME);
+        auto daoName = m_daoSettings->getDaoName();
 
         auto stat_itr = stats_index.find(
             voice::currency_statsv2::build_key(
@@ -513,6 +574,10 @@ namespace hypha
         // Sets an empty tally
         VoteTally(m_dao, proposal, m_daoSettings);
 
+        VoteTally::initBallot(m_dao, proposal.getID(), getVoiceSupply(proposal));
+
+        Vote::initIndex(m_dao, proposal.getID());
+
         ContentWrapper::insertOrReplace(
             *proposal.getContentWrapper().getGroupOrFail(DETAILS),
             Content { common::STATE, common::STATE_PROPOSED }
@@ -2,6 +2,7 @@
 #include <common.hpp>
 #include <util.hpp>
 #include <member.hpp>
+#include <period.hpp>
 #include <typed_document.hpp>
 
 namespace hypha
@@ -42,7 +43,7 @@ namespace hypha
         //Check start period
         Document period = getItemDoc(START_PERIOD, common::PERIOD, cw);
 
-        auto calendarId = Edge::get(m_dao.get_self(), period.getID(), common::CALENDAR).getToNode();
+        auto calendarId = Period(&m_dao, period.getID()).getCalendarID();
 
         //TODO Period: Remove since period refactor will no longer point to DAO
         EOS_CHECK(
@@ -183,6 +183,8 @@ namespace hypha
             //This makes the last period partially claimable to the point where the assignment is suspended
             m_dao.modifyCommitment(assignment, 0, std::nullopt, common::MOD_WITHDRAW);
         }
+
+        Assignment::eraseClaimCursor(m_dao, assignment.getID());
       } break;
       case common::ROLE_NAME.value: {
         //We don't have to do anything special for roles
@@ -0,0 +1,53 @@
+#include <salary.hpp>
+#include <fixed_point.hpp>
+#include <logger/logger.hpp>
+
+namespace hypha
+{
+    AssetBatch& operator+=(AssetBatch& self, const AssetBatch& other)
+    {
+      self.peg += other.peg;
+      self.reward += other.reward;
+      self.voice += other.voice;
+      return self;  
+    }
+
+    AssetBatch calculateSalaries(const SalaryConfig& salaryConf, const AssetBatch& tokens)
+    {
+        AssetBatch salaries;
+
+        //Time share, deferred percentage and multipliers are all in base 100
+        const int64_t BASE = 100;
+
+        if (tokens.peg.is_valid()) {
+            salaries.peg = fixed::convert(
+                salaryConf.periodSalary,
+                tokens.peg.symbol,
+                salaryConf.timeShare * (BASE - salaryConf.deferredPerc) * salaryConf.pegMultipler,
+                BASE * BASE * BASE
+            );
+        }
+
+        if (tokens.reward.is_valid()) {
+            salaries.reward = fixed::convert(
+                salaryConf.periodSalary,
+                tokens.reward.symbol,
+                salaryConf.timeShare * salaryConf.deferredPerc * salaryConf.rewardMultipler,
+                BASE * BASE * BASE
+            );
+        }
+
+        EOS_CHECK(tokens.voice.is_valid(), "Voice token must be valid");
+
+        //Voice is a must, should be always valid
+        //TODO: Make the multipler configurable
+        salaries.voice = fixed::convert(
+            salaryConf.periodSalary,
+            tokens.voice.symbol,
+            salaryConf.timeShare * salaryConf.voiceMultipler,
+            BASE * BASE
+        );
+
+        return salaries;
+    }
+}
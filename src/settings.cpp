@@ -53,6 +53,7 @@ Settings::Settings(dao& dao,
 
     ContentWrapper::insertOrReplace(*settings, setting);
 
+    invalidateIndex();
     update();
   }
 
@@ -82,6 +83,7 @@ Settings::Settings(dao& dao,
       ContentWrapper::insertOrReplace(*settings, Content{kv.first, kv.second});
     }
 
+    invalidateIndex();
     update();
   }
 
@@ -102,6 +104,7 @@ Settings::Settings(dao& dao,
 
     settings->push_back(setting);
 
+    invalidateIndex();
     update();
   }
   
@@ -126,6 +129,7 @@ Settings::Settings(dao& dao,
       updateDateContent
     );
 
+    invalidateIndex();
     update();
   }
 
@@ -164,7 +168,239 @@ Settings::Settings(dao& dao,
       updateDateContent
     );
 
+    invalidateIndex();
     update();
   }
 
-  }
\ No newline at end of file
+  static const char* getHotSettingKey(size_t setting)
+  {
+    static const char* keys[] = {
+      common::VOICE_TOKEN,
+      common::REWARD_TOKEN,
+      common::PEG_TOKEN,
+      DAO_NAME,
+      VOTING_QUORUM_FACTOR_X100,
+      VOTING_ALIGNMENT_FACTOR_X100
+    };
+
+    return keys[setting];
+  }
+
+  const eosio::asset& Settings::getVoiceToken()
+  {
+    if (auto content = findHotSetting(HOT_VOICE_TOKEN)) {
+      if (auto p = std::get_if<eosio::asset>(&content->value)) {
+        return *p;
+      }
+    }
+
+    return getOrFail<eosio::asset>(common::VOICE_TOKEN);
+  }
+
+  eosio::asset Settings::getRewardToken()
+  {
+    if (auto content = findHotSetting(HOT_REWARD_TOKEN)) {
+      if (auto p = std::get_if<eosio::asset>(&content->value)) {
+        return *p;
+      }
+    }
+
+    return getSettingOrDefault<eosio::asset>(common::REWARD_TOKEN);
+  }
+
+  eosio::asset Settings::getPegToken()
+  {
+    if (auto content = findHotSetting(HOT_PEG_TOKEN)) {
+      if (auto p = std::get_if<eosio::asset>(&content->value)) {
+        return *p;
+      }
+    }
+
+    return getSettingOrDefault<eosio::asset>(common::PEG_TOKEN);
+  }
+
+  const eosio::name& Settings::getDaoName()
+  {
+    if (auto content = findHotSetting(HOT_DAO_NAME)) {
+      if (auto p = std::get_if<eosio::name>(&content->value)) {
+        return *p;
+      }
+    }
+
+    return getOrFail<eosio::name>(DAO_NAME);
+  }
+
+  int64_t Settings::getQuorumFactor()
+  {
+    if (auto content = findHotSetting(HOT_QUORUM_FACTOR)) {
+      if (auto p = std::get_if<int64_t>(&content->value)) {
+        return *p;
+      }
+    }
+
+    return getOrFail<int64_t>(VOTING_QUORUM_FACTOR_X100);
+  }
+
+  int64_t Settings::getAlignmentFactor()
+  {
+    if (auto content = findHotSetting(HOT_ALIGNMENT_FACTOR)) {
+      if (auto p = std::get_if<int64_t>(&content->value)) {
+        return *p;
+      }
+    }
+
+    return getOrFail<int64_t>(VOTING_ALIGNMENT_FACTOR_X100);
+  }
+
+  Content* Settings::findHotSetting(HotSetting setting)
+  {
+    if (isIndexStale()) {
+      buildIndex();
+    }
+
+    auto pos = m_hotSettings[setting];
+
+    if (pos < 0) {
+      return nullptr;
+    }
+
+    auto& item = Document::getContentGroups()[SETTINGS_IDX][pos];
+
+    return item.label == getHotSettingKey(setting) ? &item : nullptr;
+  }
+
+  bool Settings::isIndexStale()
+  {
+    auto& groups = Document::getContentGroups();
+
+    return !m_indexed ||
+           m_groupSizes.size() != groups.size() ||
+           (!groups.empty() && groups[SETTINGS_IDX].size() != m_groupSizes[SETTINGS_IDX]);
+  }
+
+  void Settings::invalidateIndex()
+  {
+    m_indexed = false;
+  }
+
+  void Settings::buildIndex()
+  {
+    TRACE_FUNCTION()
+
+    auto& groups = Document::getContentGroups();
+
+    m_groupIndex.clear();
+    m_itemIndex.clear();
+    m_groupSizes.clear();
+
+    m_itemIndex.resize(groups.size());
+    m_groupSizes.reserve(groups.size());
+
+    for (size_t groupIdx = 0; groupIdx < groups.size(); ++groupIdx) {
+      auto& group = groups[groupIdx];
+
+      m_groupSizes.push_back(group.size());
+
+      for (size_t itemIdx = 0; itemIdx < group.size(); ++itemIdx) {
+        auto& item = group[itemIdx];
+
+        //Only the first occurrence is indexed, same as ContentWrapper lookups
+        m_itemIndex[groupIdx].emplace(item.label, itemIdx);
+
+        if (item.label == CONTENT_GROUP_LABEL) {
+          if (auto label = std::get_if<std::string>(&item.value)) {
+            m_groupIndex.emplace(*label, static_cast<int64_t>(groupIdx));
+          }
+        }
+      }
+    }
+
+    //Resolve the positions of the hot settings in the settings group
+    for (size_t setting = 0; setting < HOT_SETTINGS_COUNT; ++setting) {
+      m_hotSettings[setting] = -1;
+
+      if (groups.empty()) {
+        continue;
+      }
+
+      auto& items = m_itemIndex[SETTINGS_IDX];
+
+      if (auto itemIt = items.find(getHotSettingKey(setting)); itemIt != items.end()) {
+        m_hotSettings[setting] = static_cast<int64_t>(itemIt->second);
+      }
+    }
+
+    m_indexed = true;
+  }
+
+  Content* Settings::findSetting(int64_t groupIdx, const std::string& key)
+  {
+    auto& groups = Document::getContentGroups();
+
+    //Second attempt only happens if the index was stale
+    for (int attempt = 0; attempt < 2; ++attempt) {
+
+      if (!m_indexed || m_groupSizes.size() != groups.size()) {
+        buildIndex();
+      }
+
+      if (groupIdx < 0 || static_cast<size_t>(groupIdx) >= groups.size()) {
+        return nullptr;
+      }
+
+      auto& group = groups[groupIdx];
+
+      if (group.size() != m_groupSizes[groupIdx]) {
+        invalidateIndex();
+        continue;
+      }
+
+      auto& items = m_itemIndex[groupIdx];
+
+      auto itemIt = items.find(key);
+
+      if (itemIt == items.end()) {
+        return nullptr;
+      }
+
+      if (group[itemIt->second].label == key) {
+        return &group[itemIt->second];
+      }
+
+      invalidateIndex();
+    }
+
+    return nullptr;
+  }
+
+  Content* Settings::findSetting(const std::string& group, const std::string& key)
+  {
+    auto& groups = Document::getContentGroups();
+
+    for (int attempt = 0; attempt < 2; ++attempt) {
+
+      if (!m_indexed || m_groupSizes.size() != groups.size()) {
+        buildIndex();
+      }
+
+      auto groupIt = m_groupIndex.find(group);
+
+      if (groupIt == m_groupIndex.end()) {
+        return nullptr;
+      }
+
+      //Verify the group is still at the indexed position
+      if (auto label = findSetting(groupIt->second, CONTENT_GROUP_LABEL);
+          label &&
+          std::holds_alternative<std::string>(label->value) &&
+          std::get<std::string>(label->value) == group) {
+        return findSetting(groupIt->second, key);
+      }
+
+      invalidateIndex();
+    }
+
+    return nullptr;
+  }
+
+}
\ No newline at end of file
@@ -34,6 +34,51 @@ time_point TimeShare::getStartDate()
          ->getAs<time_point>();
 }
 
+int64_t TimeShare::getTimeShare()
+{
+  return getContentWrapper()
+         .getOrFail(DETAILS, TIME_SHARE)
+         ->getAs<int64_t>();
+}
+
+void TimeShare::addToTimeline(uint64_t assignment)
+{
+  dao::time_share_table timeline(contract, assignment);
+
+  timeline.emplace(contract, [&](dao::TimeShareEntry& entry) {
+    entry.start_sec = getStartDate().sec_since_epoch();
+    entry.time_share = getTimeShare();
+    entry.time_share_id = getID();
+  });
+}
+
+void TimeShare::initTimeline(name contract, uint64_t assignment)
+{
+  dao::time_share_table timeline(contract, assignment);
+
+  if (timeline.begin() != timeline.end()) {
+    return;
+  }
+
+  std::optional<TimeShare> timeShare = TimeShare(
+    contract,
+    Edge::get(contract, assignment, common::INIT_TIME_SHARE).getToNode()
+  );
+
+  for (; timeShare; timeShare = timeShare->getNext()) {
+    timeShare->addToTimeline(assignment);
+  }
+}
+
+void TimeShare::eraseTimeline(name contract, uint64_t assignment)
+{
+  dao::time_share_table timeline(contract, assignment);
+
+  for (auto it = timeline.begin(); it != timeline.end();) {
+    it = timeline.erase(it);
+  }
+}
+
 ContentGroups TimeShare::constructContentGroups(int64_t timeShare, time_point startDate, uint64_t assignment) 
 {
   return {
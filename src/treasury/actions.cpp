@@ -4,6 +4,7 @@
 #include <numeric>
 
 #include <member.hpp>
+#include <fixed_point.hpp>
 #include <document_graph/edge.hpp>
 
 #include <eosio/action.hpp>
@@ -109,7 +110,12 @@ ACTION dao::newmsigpay(name treasurer, uint64_t treasury_id, std::vector<Redempt
 
   Document msigInfoDoc(get_self(), get_self(), msigInfoCgs);
 
-  auto daoId = Treasury(*this, treasury_id).getDaoID();
+  Treasury treasury(*this, treasury_id);
+
+  //Treasurer permissions are checked once for the whole batch
+  treasury.checkTreasurerAuth();
+
+  auto daoId = treasury.getDaoID();
 
   for (auto& signer : signers) {
 
@@ -124,35 +130,89 @@ ACTION dao::newmsigpay(name treasurer, uint64_t treasury_id, std::vector<Redempt
 
   auto nativeToken = dhoSettings->getOrFail<asset>(trsycommon::fields::NATIVE_TOKEN);
 
+  //Group the payments of each redemption so every redemption is validated and updated once
+  std::map<uint64_t, asset> redemptionTotals;
+
+  for (auto& redemptionInfo : payments) {
+    EOS_CHECK(
+      redemptionInfo.amount.amount > 0,
+      "Amount must be greater to 0"
+    )
+
+    auto [it, inserted] = redemptionTotals.emplace(redemptionInfo.redemption_id, redemptionInfo.amount);
+
+    if (!inserted) {
+      it->second += redemptionInfo.amount;
+    }
+  }
+
+  for (auto& [redemptionID, total] : redemptionTotals) {
+    Redemption redemption(*this, redemptionID);
+
+    EOS_CHECK(
+      Edge::exists(get_self(), treasury_id, redemptionID, trsycommon::links::REDEMPTION),
+      "Redemption must belong to the provided DAO Treasury"
+    )
+
+    const auto& amountRequested = redemption.getAmountRequested();
+
+    auto amountDue = amountRequested - redemption.getAmountPaid();
+    
+    //Check the total paid to the redemption is less or equal to the amount due
+    EOS_CHECK(
+      total <= amountDue,
+      to_str(
+        "Redemption amount must be less than amount due. Original requested amount: ", amountRequested,
+        "; Paid amount: ", redemption.getAmountPaid(),
+        ". The remaining amount due is: ", amountDue,
+        " and you attempted to create new payments for: ", total
+      )
+    );
+
+    redemption.setAmountPaid(redemption.getAmountPaid() + total);
+    redemption.update();
+  }
+
   eosio::transaction trx;
 
   trx.expiration = eosio::current_time_point() + eosio::days(5);
 
-  //Hardcode for now the price
-  constexpr auto NATIVE_TO_USD_RATIO = 1.25;
+  //Hardcode for now the price, 1 native token is 1.25 USD
+  constexpr int64_t NATIVE_PER_USD_NUM = 4;
+  constexpr int64_t NATIVE_PER_USD_DEN = 5;
+
+  std::vector<uint64_t> paymentIDs;
+
+  paymentIDs.reserve(payments.size());
 
   for (auto& redemptionInfo : payments) {
-    auto trsyPay = createTrsyPayment(*this, treasurer, treasury_id, redemptionInfo, true);
+    
+    auto nativeAmountPaid = fixed::convert(
+      redemptionInfo.amount,
+      nativeToken.symbol,
+      NATIVE_PER_USD_NUM,
+      NATIVE_PER_USD_DEN
+    );
 
-    Edge(get_self(), get_self(), trsyPay.getId(), msigInfoDoc.getID(), "msiginfo"_n);
-    Edge(get_self(), get_self(), msigInfoDoc.getID(), trsyPay.getId(), trsycommon::links::PAYMENT);
+    auto paymentNotes = redemptionInfo.notes.empty() ? std::string("Redemption payment") : redemptionInfo.notes;
 
-    auto calculatedNative = normalizeToken(redemptionInfo.amount) / NATIVE_TO_USD_RATIO;
+    //Payment documents are created with the native amount already set
+    TrsyPayment trsyPay(*this, treasury_id, redemptionInfo.redemption_id, TrsyPaymentData {
+      .creator = treasurer,
+      .amount_paid = redemptionInfo.amount,
+      .native_amount_paid = nativeAmountPaid,
+      .notes = std::move(redemptionInfo.notes)
+    });
 
-    std::string notes;
+    paymentIDs.push_back(trsyPay.getId());
 
     //Notes structure receiver;payment_id;notes
-    notes = to_str(
+    auto notes = to_str(
       redemptionInfo.receiver, ";", 
       trsyPay.getId(), ";", 
-      redemptionInfo.notes.empty() ? "Redemption payment" : redemptionInfo.notes
+      paymentNotes
     );
 
-    auto nativeAmountPaid = denormalizeToken(calculatedNative, nativeToken);
-
-    trsyPay.setNativeAmountPaid(nativeAmountPaid);
-    trsyPay.update();
-
     trx.actions.push_back(eosio::action(
       eosio::permission_level{treasuryAccount, "active"_n},
       "eosio.token"_n,
@@ -161,6 +221,11 @@ ACTION dao::newmsigpay(name treasurer, uint64_t treasury_id, std::vector<Redempt
     ));
   }
 
+  for (auto paymentID : paymentIDs) {
+    Edge(get_self(), get_self(), paymentID, msigInfoDoc.getID(), "msiginfo"_n);
+    Edge(get_self(), get_self(), msigInfoDoc.getID(), paymentID, trsycommon::links::PAYMENT);
+  }
+
   //Setup single multisig transaction for all redemptions (might want to create 1 per redemptio or make it optional)
   eosio::action(
     eosio::permission_level{get_self(), "active"_n},
@@ -357,6 +422,36 @@ ACTION dao::setrsysttngs(uint64_t treasury_id, const std::map<std::string, Conte
   settings->setSettings(group.value_or(SETTINGS), kvs);
 }
 
+ACTION dao::idxtrsyauth(uint64_t treasury_id)
+{
+  TRACE_FUNCTION();
+
+  eosio::require_auth(get_self());
+
+  Treasury(*this, treasury_id).indexAuth();
+}
+
+ACTION dao::indexbals(uint64_t from_edge_id)
+{
+  TRACE_FUNCTION();
+
+  eosio::require_auth(get_self());
+
+  const size_t MAX_EDGES_PER_ACTION = 200;
+
+  //Each batch runs in its own transaction through the deferred queue
+  if (auto next = Balance::indexBalances(*this, from_edge_id, MAX_EDGES_PER_ACTION)) {
+    eosio::action act(
+      eosio::permission_level(get_self(), eosio::name("active")),
+      get_self(),
+      eosio::name("indexbals"),
+      std::make_tuple(*next)
+    );
+
+    schedule_deferred_action(eosio::time_point_sec(eosio::current_time_point()), act);
+  }
+}
+
 
 struct approval {
   eosio::permission_level level;
@@ -18,6 +18,8 @@ Balance::Balance(dao& dao, uint64_t id)
 Balance::Balance(dao& dao, uint64_t owner, Data data)
     : TypedDocument(dao, types::BALANCE)
 {
+    auto daoID = data.dao;
+
     auto cgs = convert(std::move(data));
 
     initializeDocument(dao, cgs);
@@ -25,16 +27,29 @@ Balance::Balance(dao& dao, uint64_t owner, Data data)
     //Initialize Edges
     Edge(dao.get_self(), dao.get_self(), owner, getId(), links::REDEEM_BALANCE);
     Edge(dao.get_self(), dao.get_self(), getId(), owner, links::BALANCE_OWNER);
+
+    addToIndex(dao, getId(), owner, static_cast<uint64_t>(daoID));
 }
 
 Balance Balance::getOrCreate(dao& dao, uint64_t daoID, uint64_t owner)
 {
+    dao::treasury_balance_table balances(dao.get_self(), dao.get_self().value);
+
+    auto byOwnerDao = balances.get_index<name("byownerdao")>();
+
+    if (auto it = byOwnerDao.find(dao::TreasuryBalance::build_key(owner, daoID)); 
+        it != byOwnerDao.end()) {
+        return Balance(dao, it->balance_id);
+    }
+
+    //Balances created before the balances table existed might not be indexed yet
     auto balanceEdges = dao.getGraph().getEdgesFrom(owner, links::REDEEM_BALANCE);
 
     //Check if the member has an existing balance document for the required DAO
     for (auto& edge : balanceEdges) {
         Balance balance(dao, edge.getToNode());
         if (balance.getDaoID() == daoID) {
+            addToIndex(dao, balance.getId(), owner, daoID);
             return balance;
         }
     }
@@ -52,6 +67,48 @@ Balance Balance::getOrCreate(dao& dao, uint64_t daoID, uint64_t owner)
     });
 }
 
+std::optional<uint64_t> Balance::indexBalances(dao& dao, uint64_t fromEdgeID, size_t maxScanned)
+{
+    Edge::edge_table edges(dao.get_self(), dao.get_self().value);
+
+    auto byName = edges.get_index<name("edgename")>();
+
+    auto it = byName.lower_bound(links::REDEEM_BALANCE.value);
+
+    //Continue from the given edge, if it was erased meanwhile start over
+    //since balances that are already indexed are skipped
+    if (auto edgeIt = edges.find(fromEdgeID); 
+        edgeIt != edges.end() && edgeIt->edge_name == links::REDEEM_BALANCE) {
+        it = byName.iterator_to(*edgeIt);
+    }
+
+    for (size_t i = 0; it != byName.end() && it->edge_name == links::REDEEM_BALANCE && i < maxScanned; ++it, ++i) {
+        Balance balance(dao, it->to_node);
+        addToIndex(dao, balance.getId(), it->from_node, balance.getDaoID());
+    }
+
+    if (it != byName.end() && it->edge_name == links::REDEEM_BALANCE) {
+        return it->id;
+    }
+
+    return std::nullopt;
+}
+
+void Balance::addToIndex(dao& dao, uint64_t balanceID, uint64_t owner, uint64_t daoID)
+{
+    dao::treasury_balance_table balances(dao.get_self(), dao.get_self().value);
+
+    if (balances.find(balanceID) != balances.end()) {
+        return;
+    }
+
+    balances.emplace(dao.get_self(), [&](dao::TreasuryBalance& row) {
+        row.balance_id = balanceID;
+        row.owner_id = owner;
+        row.dao_id = daoID;
+    });
+}
+
 void Balance::add(const asset& quantity) 
 {
     auto newQuantity = getQuantity() + quantity;
@@ -55,6 +55,8 @@ Treasury::Treasury(dao& dao, Data data)
         daoID, 
         links::TREASURY_OF
     );
+
+    indexAuth();
 }
 
 void Treasury::removeTreasurer(uint64_t memberID)
@@ -69,6 +71,8 @@ void Treasury::removeTreasurer(uint64_t memberID)
               memberID,
               getId(),
               links::TREASURER_OF).erase();
+
+    setAuthRole(getDao(), getDaoID(), Member(getDao(), memberID).getAccount(), auth_roles::TREASURER, false);
 }
 
 void Treasury::addTreasurer(uint64_t memberID)
@@ -84,6 +88,8 @@ void Treasury::addTreasurer(uint64_t memberID)
                    memberID,
                    getId(),
                    links::TREASURER_OF);
+
+    setAuthRole(getDao(), getDaoID(), Member(getDao(), memberID).getAccount(), auth_roles::TREASURER, true);
 }
 
 void Treasury::checkTreasurerAuth() 
@@ -93,27 +99,107 @@ void Treasury::checkTreasurerAuth()
       return;
     }
 
-    auto treasurerEdges = getDao()
-                          .getGraph()
-                          .getEdgesFrom(getId(), links::TREASURER);
-
-    auto adminEdges = getDao()
-                      .getGraph()
-                      .getEdgesFrom(getDaoID(), hypha::common::ADMIN);
-    
-    treasurerEdges.insert(
-        treasurerEdges.end(), 
-        std::move_iterator(adminEdges.end()),
-        std::move_iterator(adminEdges.begin())
-    );
-        
-    EOS_CHECK(
-      std::any_of(treasurerEdges.begin(), treasurerEdges.end(), [this](const Edge& edge) {
-        Member member(getDao(), edge.to_node);
-        return eosio::has_auth(member.getAccount());
-      }),
-      to_str("Only treasurers of the dao are allowed to perform this action")
-    );
+    if (getDao().isTreasuryAuthCached(getId())) {
+      return;
+    }
+
+    auto daoID = static_cast<uint64_t>(getDaoID());
+
+    dao::treasury_auth_dao_table indexedDaos(getDao().get_self(), getDao().get_self().value);
+
+    if (indexedDaos.find(daoID) != indexedDaos.end()) {
+      dao::treasury_auth_table auths(getDao().get_self(), daoID);
+
+      EOS_CHECK(
+        std::any_of(auths.begin(), auths.end(), [](const dao::TreasuryAuth& auth) {
+          return eosio::has_auth(auth.account);
+        }),
+        to_str("Only treasurers of the dao are allowed to perform this action")
+      );
+    }
+    else {
+      auto treasurerEdges = getDao()
+                            .getGraph()
+                            .getEdgesFrom(getId(), links::TREASURER);
+
+      auto adminEdges = getDao()
+                        .getGraph()
+                        .getEdgesFrom(daoID, hypha::common::ADMIN);
+      
+      treasurerEdges.insert(
+          treasurerEdges.end(), 
+          std::move_iterator(adminEdges.begin()),
+          std::move_iterator(adminEdges.end())
+      );
+          
+      EOS_CHECK(
+        std::any_of(treasurerEdges.begin(), treasurerEdges.end(), [this](const Edge& edge) {
+          Member member(getDao(), edge.to_node);
+          return eosio::has_auth(member.getAccount());
+        }),
+        to_str("Only treasurers of the dao are allowed to perform this action")
+      );
+    }
+
+    getDao().cacheTreasuryAuth(getId());
+}
+
+void Treasury::indexAuth()
+{
+    auto daoID = static_cast<uint64_t>(getDaoID());
+
+    dao::treasury_auth_table auths(getDao().get_self(), daoID);
+
+    for (auto it = auths.begin(); it != auths.end();) {
+      it = auths.erase(it);
+    }
+
+    for (auto& edge : getDao().getGraph().getEdgesFrom(getId(), links::TREASURER)) {
+      setAuthRole(getDao(), daoID, Member(getDao(), edge.to_node).getAccount(), auth_roles::TREASURER, true);
+    }
+
+    for (auto& edge : getDao().getGraph().getEdgesFrom(daoID, hypha::common::ADMIN)) {
+      setAuthRole(getDao(), daoID, Member(getDao(), edge.to_node).getAccount(), auth_roles::ADMIN, true);
+    }
+
+    dao::treasury_auth_dao_table indexedDaos(getDao().get_self(), getDao().get_self().value);
+
+    if (indexedDaos.find(daoID) == indexedDaos.end()) {
+      indexedDaos.emplace(getDao().get_self(), [&](dao::TreasuryAuthDao& row) {
+        row.dao_id = daoID;
+      });
+    }
+}
+
+void Treasury::setAuthRole(dao& dao, uint64_t daoID, const eosio::name& account, uint8_t role, bool enabled)
+{
+    dao::treasury_auth_table auths(dao.get_self(), daoID);
+
+    auto it = auths.find(account.value);
+
+    if (enabled) {
+      if (it == auths.end()) {
+        auths.emplace(dao.get_self(), [&](dao::TreasuryAuth& auth) {
+          auth.account = account;
+          auth.roles = role;
+        });
+      }
+      else {
+        auths.modify(it, dao.get_self(), [&](dao::TreasuryAuth& auth) {
+          auth.roles |= role;
+        });
+      }
+    }
+    else if (it != auths.end()) {
+      if ((it->roles & ~role) == 0) {
+        auths.erase(it);
+      }
+      else {
+        auths.modify(it, dao.get_self(), [&](dao::TreasuryAuth& auth) {
+          auth.roles &= ~role;
+        });
+      }
+    }
 }
 
 Treasury Treasury::getFromDaoID(dao& dao, uint64_t daoID)
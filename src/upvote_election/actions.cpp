@@ -543,6 +543,7 @@ namespace hypha {
                     if (!Member::isMember(*this, dao_id, mem) &&
                         !Member::isCommunityMember(*this, dao_id, mem)) {
                         Edge(get_self(), get_self(), dao_id, member.getID(), common::COMMEMBER);
+                        Member::setMembership(*this, dao_id, mem, membership::COMMUNITY, true);
                     }
 
                     if (mem == election.lead_representative) {
@@ -852,6 +853,10 @@ namespace hypha {
 
                     assignDelegateBadges(*this, daoId, election.getId(), winners, headDelegate);
 
+                    for (auto& electionRound : election.getRounds()) {
+                        electionRound.eraseVotes();
+                    }
+
                     election.setStatus(upvote_common::upvote_status::FINISHED);
                 }
             }
@@ -892,6 +897,10 @@ namespace hypha {
         if (isOngoing) {
             /// TODO get all rounds, then delete them all
             Edge::get(get_self(), daoId, election.getId(), upvote_common::links::ONGOING_ELECTION).erase();
+
+            for (auto& electionRound : election.getRounds()) {
+                electionRound.eraseVotes();
+            }
         }
         else {
             Edge::get(get_self(), daoId, election.getId(), upvote_common::links::UPCOMING_ELECTION).erase();
@@ -5,7 +5,7 @@
 #include <document_graph/edge.hpp>
 
 #include "dao.hpp"
-#include <unordered_map> 
+#include <algorithm>
 
 namespace hypha::upvote_election {
 
@@ -62,81 +62,180 @@ bool ElectionGroup::isElectionRoundMember(uint64_t accountId)
     );
 } 
 
-void ElectionGroup::vote(int64_t from, int64_t to)
+namespace {
+
+using UpvoteCount = dao::UpvoteCount;
+
+size_t getCountIdx(std::vector<UpvoteCount>& counts, uint64_t memberID)
 {
+    auto it = std::find_if(counts.begin(), counts.end(), [memberID](const UpvoteCount& count) {
+        return count.member_id == memberID;
+    });
 
-    // get all existing vote edges
-    std::vector<Edge> voteEdges = getDao().getGraph().getEdgesFrom(getId(), links::UP_VOTE_VOTE);
-    
-    // get the member count
-    auto memcount = getMemberCount();
-    uint64_t votesToWin = memcount * 2 / 3 + 1;
+    if (it != counts.end()) {
+        return std::distance(counts.begin(), it);
+    }
 
-    // iterate over vote edges - calculate who has the most votes and find the "from" edge
-    std::unordered_map<int64_t, int> voteCount;
-    std::unordered_map<int64_t, bool> selfVotes;
+    counts.push_back(UpvoteCount{ .member_id = memberID, .votes = 0, .self_voted = false });
 
-    bool existingVote = false;
-    int64_t majorityWinner = -1;
+    return counts.size() - 1;
+}
+
+bool hasMajority(const UpvoteCount& count, uint64_t votesToWin)
+{
+    return count.votes >= votesToWin && count.self_voted;
+}
+
+dao::upvote_tally_table::const_iterator getTally(ElectionGroup& group, dao::upvote_tally_table& tallies)
+{
+    auto& contract = group.getDao();
+    auto groupID = group.getId();
+
+    if (auto it = tallies.find(groupID); it != tallies.end()) {
+        return it;
+    }
+
+    //Groups with votes cast before the votes table existed keep them as
+    //documents, move them to the table so the tally starts from them
+    dao::upvote_vote_table votes(contract.get_self(), contract.get_self().value);
+
+    uint64_t votesToWin = group.getMemberCount() * 2 / 3 + 1;
+
+    return tallies.emplace(contract.get_self(), [&](dao::UpvoteTally& tally) {
+        tally.group_id = groupID;
+        tally.winner = -1;
+
+        auto voteEdges = contract.getGraph().getEdgesFrom(groupID, links::UP_VOTE_VOTE);
+
+        for (auto& edge : voteEdges) {
+            UpVoteVote upvote(contract, edge.getToNode());
+
+            uint64_t voterID = upvote.getVoterId();
+            uint64_t votedID = upvote.getVotedId();
+
+            votes.emplace(contract.get_self(), [&](dao::UpvoteVote& vote) {
+                vote.id = votes.available_primary_key();
+                vote.group_id = groupID;
+                vote.voter_id = voterID;
+                vote.voted_id = votedID;
+            });
+
+            auto& count = tally.counts[getCountIdx(tally.counts, votedID)];
+            count.votes++;
+            count.self_voted = count.self_voted || voterID == votedID;
+
+            //The vote is kept in the table from now on
+            contract.getGraph().eraseDocument(upvote.getId(), true);
+        }
+
+        for (auto& count : tally.counts) {
+            if (hasMajority(count, votesToWin)) {
+                tally.winner = count.member_id;
+            }
+        }
+    });
+}
+
+}
 
-    for (auto& edge : voteEdges) {
-        UpVoteVote upvote(getDao(), edge.getToNode());
+void ElectionGroup::vote(int64_t from, int64_t to)
+{
+    auto self = getDao().get_self();
+
+    dao::upvote_tally_table tallies(self, self.value);
+    auto tallyIt = getTally(*this, tallies);
+
+    dao::upvote_vote_table votes(self, self.value);
+    auto byVoter = votes.get_index<eosio::name("bygroupvoter")>();
+    auto voteIt = byVoter.find(dao::UpvoteVote::build_key(getId(), from));
 
-        int64_t voted_id = upvote.getVotedId();
-        int64_t voter_id = upvote.getVoterId();
+    std::optional<uint64_t> previousVote;
 
+    if (voteIt != byVoter.end()) {
         // If the voter has already voted before, we change their 
         // vote to the new voted "to"
-        if (voter_id == from) {
-            existingVote = true;
-            upvote.setVotedId(to);
-            upvote.update();
-            voted_id = to;
+        if (voteIt->voted_id == static_cast<uint64_t>(to)) {
+            return;
         }
 
-        voteCount[voted_id]++;
+        previousVote = voteIt->voted_id;
 
-        // check for winner
-        if (voteCount[voted_id] >= votesToWin) {
-            majorityWinner = voted_id;
-        }
-        
-        // keep track of self votes
-        if (voted_id == voter_id) {
-            selfVotes[voted_id] = true;
-        }
+        byVoter.modify(voteIt, self, [&](dao::UpvoteVote& vote) {
+            vote.voted_id = to;
+        });
     }
+    else {
+        votes.emplace(self, [&](dao::UpvoteVote& vote) {
+            vote.id = votes.available_primary_key();
+            vote.group_id = getId();
+            vote.voter_id = from;
+            vote.voted_id = to;
+        });
+    }
+
+    uint64_t votesToWin = getMemberCount() * 2 / 3 + 1;
+
+    int64_t majorityWinner = -1;
+
+    tallies.modify(tallyIt, self, [&](dao::UpvoteTally& tally) {
+        if (previousVote) {
+            auto& previous = tally.counts[getCountIdx(tally.counts, *previousVote)];
+            previous.votes--;
+            if (*previousVote == static_cast<uint64_t>(from)) {
+                previous.self_voted = false;
+            }
+        }
 
-    if (!existingVote) {
+        auto& current = tally.counts[getCountIdx(tally.counts, to)];
+        current.votes++;
         if (from == to) {
-            selfVotes[from] = true;
+            current.self_voted = true;
         }
-        // Create a new vote
-        UpVoteVote vote(getDao(), getId(), UpVoteVoteData{
-            .voter_id = from,
-            .voted_id = to
-        });
 
-        voteCount[to]++;
+        //Only one member can hold more than 2/3 of the votes, so it's enough
+        //to re-check the current winner and the member that just got the vote
+        if (tally.winner != -1 &&
+            !hasMajority(tally.counts[getCountIdx(tally.counts, tally.winner)], votesToWin)) {
+            tally.winner = -1;
+        }
 
-        // check for winner
-        if (voteCount[to] >= votesToWin) {
-            majorityWinner = to;
+        if (hasMajority(tally.counts[getCountIdx(tally.counts, to)], votesToWin)) {
+            tally.winner = to;
         }
+
+        majorityWinner = tally.winner;
+    });
+
+    if (majorityWinner == getWinner()) {
+        return;
     }
-    std::vector<Edge> winnerEdges = getDao().getGraph().getEdgesFrom(getId(), links::GROUP_WINNER);
-    if (winnerEdges.size() > 0) {
-        winnerEdges[0].erase();
+
+    if (auto [exists, edge] = Edge::getIfExists(self, getId(), links::GROUP_WINNER); exists) {
+        edge.erase();
     }
 
-    if (majorityWinner > 0 && selfVotes[majorityWinner]) {
-        setWinner(majorityWinner);
-        Edge(getDao().get_self(), getDao().get_self(), getId(), majorityWinner, links::GROUP_WINNER);
-    } else {
-        setWinner(-1);
+    if (majorityWinner != -1) {
+        Edge(self, self, getId(), majorityWinner, links::GROUP_WINNER);
     }
+
+    setWinner(majorityWinner);
     update();
-    
+}
+
+void ElectionGroup::eraseVotes()
+{
+    auto self = getDao().get_self();
+
+    dao::upvote_vote_table votes(self, self.value);
+    auto byVoter = votes.get_index<eosio::name("bygroupvoter")>();
+    auto voteIt = byVoter.lower_bound(dao::UpvoteVote::build_key(getId(), 0));
+    auto voteEnd = byVoter.lower_bound(dao::UpvoteVote::build_key(getId() + 1, 0));
+
+    while (voteIt != voteEnd) {
+        voteIt = byVoter.erase(voteIt);
+    }
+}
+
 }
 
 
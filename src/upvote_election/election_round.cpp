@@ -132,6 +132,15 @@ namespace hypha::upvote_election {
         return winners;
     }
 
+    void ElectionRound::eraseVotes()
+    {
+        std::vector<Edge> groupEdges = getDao().getGraph().getEdgesFrom(getId(), links::ELECTION_GROUP_LINK);
+        for (auto& edge : groupEdges) {
+            ElectionGroup group(getDao(), edge.getToNode());
+            group.eraseVotes();
+        }
+    }
+
     void ElectionRound::setNextRound(ElectionRound* nextRound) const
     {
         EOS_CHECK(
@@ -18,24 +18,6 @@ UpVoteVote::UpVoteVote(dao& dao, uint64_t id)
     : TypedDocument(dao, id, types::ELECTION_UP_VOTE)
 {}
 
-UpVoteVote::UpVoteVote(dao& dao, uint64_t group_id, Data data)
-    : TypedDocument(dao, types::ELECTION_UP_VOTE)
-{
-    auto cgs = convert(std::move(data));
-
-    initializeDocument(dao, cgs);
-
-    // edge from group to vote
-    Edge(
-        getDao().get_self(),
-        getDao().get_self(),
-        group_id,
-        getId(),
-        links::UP_VOTE_VOTE
-    );
-
-}
-
 // not sure we need this but we have the edge...
 uint64_t UpVoteVote::getElectionGroup()
 {
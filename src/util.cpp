@@ -4,56 +4,13 @@
 #include <document_graph/content_wrapper.hpp>
 #include <common.hpp>
 #include <logger/logger.hpp>
+#include <fixed_point.hpp>
 
 #include <cmath>
 #include <charconv>
 
 namespace hypha
 {
-    AssetBatch& operator+=(AssetBatch& self, const AssetBatch& other)
-    {
-      self.peg += other.peg;
-      self.reward += other.reward;
-      self.voice += other.voice;
-      return self;  
-    }
-
-    float getPhaseToYearRatio(Settings* daoSettings)
-    {
-        int64_t periodDurationSec = daoSettings->getOrFail<int64_t>(common::PERIOD_DURATION);
-
-        return getPhaseToYearRatio(daoSettings, periodDurationSec);       
-    }
-
-    float getPhaseToYearRatio(Settings* daoSettings, int64_t periodDuration)
-    {
-        return static_cast<float>(periodDuration) / common::YEAR_DURATION_SEC;
-    }
-
-    AssetBatch calculateSalaries(const SalaryConfig& salaryConf, const AssetBatch& tokens)
-    {
-        AssetBatch salaries;
-
-        if (tokens.peg.is_valid()) {
-            double pegSalaryPerPeriod = salaryConf.periodSalary * (1.0 - salaryConf.deferredPerc);
-            salaries.peg = denormalizeToken(pegSalaryPerPeriod * salaryConf.pegMultipler, tokens.peg);
-        }
-
-        if (tokens.reward.is_valid()) {
-            double rewardSalaryPerPeriod = (salaryConf.periodSalary * salaryConf.deferredPerc);
-            salaries.reward = denormalizeToken(rewardSalaryPerPeriod * salaryConf.rewardMultipler, tokens.reward);
-        }
-
-        EOS_CHECK(tokens.voice.is_valid(), "Voice token must be valid");
-
-        //Voice is a must, should be always valid
-        double voiceSalaryPerPeriod = salaryConf.periodSalary * salaryConf.voiceMultipler;
-        //TODO: Make the multipler configurable
-        salaries.voice = denormalizeToken(voiceSalaryPerPeriod, tokens.voice);
-
-        return salaries;
-    }
-
     ContentGroups getRootContent(const eosio::name &contract)
     {
         ContentGroups cgs ({
@@ -85,21 +42,19 @@ namespace hypha
         return std::move(cgs);
     }
 
-    double getMultiplier(Settings* settings, const char* multiplierName, double defaultVal)
+    int64_t getMultiplier(Settings* settings, const char* multiplierName, int64_t defaultVal)
     {
-        // Since multiplier is stored in base 100, we need to normalize it to base 1 i.e. 200 value means 2.0 multiplier
-        const auto MULTIPLIER_BASE = 100.0;
-        
+        // Multipliers are stored in base 100 i.e. 200 value means 2.0 multiplier
         if (auto multiplier = settings->getSettingOpt<int64_t>(multiplierName)) {
-           return static_cast<double>(*multiplier) / MULTIPLIER_BASE;
+           return *multiplier;
         }
         
         return defaultVal;
     }
 
-    eosio::asset adjustAsset(const asset &originalAsset, const float &adjustment)
+    eosio::asset adjustAsset(const asset &originalAsset, int64_t numerator, int64_t denominator)
     {
-        return eosio::asset{static_cast<int64_t>(originalAsset.amount * adjustment), originalAsset.symbol};
+        return fixed::scale(originalAsset, numerator, denominator);
     }
 
     vector<string_view> splitStringView(string_view str, char delimiter)
@@ -184,23 +139,9 @@ namespace hypha
             .send();
     }
 
-    double normalizeToken(const eosio::asset& token)
-    {
-      auto power = ::pow(10, token.symbol.precision());
-      return static_cast<double>(token.amount) / power;
-    }
-
-    eosio::asset denormalizeToken(double amountNormalized, const eosio::asset& token)
-    {
-      auto power = ::pow(10, token.symbol.precision());
-      return eosio::asset{static_cast<int64_t>(amountNormalized * power), token.symbol};
-    }
-
     int64_t getTokenUnit(const eosio::asset& token)
     {
-      auto symb =  token.symbol;
-
-      return static_cast<int64_t>(::powf(10, symb.precision()));;
+      return fixed::pow10(token.symbol.precision());
     }
 
 } // namespace hypha
\ No newline at end of file
@@ -7,7 +7,8 @@ import {
     getDetailsGroup,
     getDocumentById,
     getDocumentsByType,
-    getEdgesByFilter
+    getEdgesByFilter,
+    getLastPaymentAmounts
 } from './utils/Dao';
 import { getDaoExpect } from './utils/Expect';
 import { UnderwaterBasketweaver } from './sample-data/RoleSamples';
@@ -19,7 +20,7 @@ import { DocumentBuilder } from './utils/DocumentBuilder';
 import { setDate } from './utils/Date';
 import { getAccountPermission } from './utils/Permissions';
 import { Asset } from './types/Asset';
-import { assetToNumber, getAssetContent } from './utils/Parsers';
+import { getAssetContent } from './utils/Parsers';
 import {Dao} from "./dao/Dao";
 
 const getPeriodStartDate = (period: Document): Date => {
@@ -121,27 +122,12 @@ describe('Assignments', () => {
 
     const checkPayments = async ({ environment, husd, hypha, hvoice }) => {
 
-      //Get payment documents (last 3)
-      let docs = environment.getDaoDocuments();
+      //All the tokens of a claim are in the last payment receipt
+      const payment = getLastPaymentAmounts(environment);
 
-      let payments: any = getDocumentsByType(docs, 'payment').slice(-3);
-
-      payments = payments.map(
-        (p: Document) => assetToNumber(
-          getContent(
-            getContentGroupByLabel(p, 'details'),
-            'amount'
-          ).value[1] as string
-        )
-      )
-
-      let hyphaPayment, hvoicePayment, husdPayment;
-
-      [hyphaPayment, hvoicePayment, husdPayment] = payments;
-
-      expect(parseFloat(hyphaPayment)).toBeCloseTo(hypha, 1);
-      expect(parseFloat(hvoicePayment)).toBeCloseTo(hvoice, 1);
-      expect(parseFloat(husdPayment)).toBeCloseTo(husd, 1);
+      expect(payment.reward).toBeCloseTo(hypha, 1);
+      expect(payment.voice).toBeCloseTo(hvoice, 1);
+      expect(payment.peg).toBeCloseTo(husd, 1);
     };
 
     it('Create assignment', async () => {
@@ -423,6 +409,94 @@ describe('Assignments', () => {
         // });
     });
 
+    it('Claim several assignment periods at once', async () => {
+
+        const environment = await setupEnvironment({
+          test: {
+              tokens: {
+                  reward: {
+                      toPegRatio: Asset.fromString('8.0 REWARD')
+                  }
+              }
+          }
+        });
+
+        const dao = environment.getDao('test');
+
+        const hyphaUSDValue = dao.settings.tokens.reward.toPegRatio.toFloat();
+
+        setDate(environment, new Date(dao.periods[0].startTime), 0);
+
+        const role = await proposeAndPass(dao, UnderwaterBasketweaver, 'role', environment);
+
+        const assignee = dao.members[0];
+
+        const assignment = await proposeAndPass(dao, getAssignmentProp(role, assignee.account.accountName), 'assignment', environment);
+
+        const assignmentDetails = getContentGroupByLabel(assignment, 'details');
+
+        const periodCount = parseInt(
+          getContent(assignmentDetails, 'period_count').value[1] as string
+        );
+
+        const husd = getAssetContent(assignmentDetails, 'husd_salary_per_phase');
+
+        const hvoice = getAssetContent(assignmentDetails, 'hvoice_salary_per_phase');
+
+        const usdSalary = getAssetContent(assignmentDetails, 'usd_salary_value_per_phase');
+
+        const hypha = (usdSalary - husd) / hyphaUSDValue;
+
+        const edges = environment.getDaoEdges();
+        const docs = environment.getDaoDocuments();
+
+        const periods = [getStartPeriod(environment, assignment)];
+
+        for (let i = 0; i < periodCount; ++i) {
+
+            const nextEdge = getEdgesByFilter(edges, { from_node: last(periods).id, edge_name: 'next' });
+
+            expect(nextEdge).toHaveLength(1);
+
+            periods.push(getDocumentById(docs, nextEdge[0].to_node));
+        }
+
+        //Once the last period of the assignment is over all of them can be claimed together
+        setDate(environment, getPeriodStartDate(last(periods)), 0);
+
+        await environment.daoContract.contract.claimperiods({
+            assignment_id: assignment.id,
+            max_periods: periodCount
+        });
+
+        //A single receipt holds the tokens of every claimed period
+        await checkPayments({
+            environment,
+            husd: husd * periodCount,
+            hypha: hypha * periodCount,
+            hvoice: hvoice * periodCount
+        });
+
+        for (let i = 0; i < periodCount; ++i) {
+            getDaoExpect(environment).toHaveEdge(assignment, periods[i], 'claimed');
+        }
+
+        const payments = environment.getDaoTableRows('payments')
+                                    .filter(payment => String(payment.assignment_id) === assignment.id);
+
+        expect(payments).toHaveLength(1);
+        expect(String(payments[0].period_id)).toBe(periods[0].id);
+        expect(String(payments[0].last_period_id)).toBe(periods[periodCount - 1].id);
+        expect(payments[0].amounts).toHaveLength(3);
+
+        await expect(
+            environment.daoContract.contract.claimperiods({
+                assignment_id: assignment.id,
+                max_periods: periodCount
+            })
+        ).rejects.toThrow(/All available periods/);
+    });
+
     it('Edit assignment', async () => {
 
         let assignment: Document;
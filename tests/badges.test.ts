@@ -1,13 +1,14 @@
 import { setupEnvironment } from './setup';
 import { Document } from './types/Document';
-import { getContent, getContentGroupByLabel, getDocumentsByType, getNextPeriod } from './utils/Dao';
+import { getContent, getContentGroupByLabel, getDocumentsByType, getLastPaymentAmounts, getNextPeriod } from './utils/Dao';
 import { getDaoExpect } from './utils/Expect';
 import { UnderwaterBasketweaver } from './sample-data/RoleSamples';
 import { DaoBlockchain } from './dao/DaoBlockchain';
 import { getAssignmentProposal, getStartPeriod } from './sample-data/AssignmentSamples';
 import { proposeAndPass } from './utils/Proposal';
 import { getBadgeAssignmentProposal, getBadgeProposal, masterOfPuppets, masterOfPuppetsAssignment } from './sample-data/BadgeSamples';
-import { assetToNumber, fixDecimals, getAssetContent } from './utils/Parsers';
+import { fixDecimals, getAssetContent } from './utils/Parsers';
+import { getAccountPermission } from './utils/Permissions';
 
 describe('Badges', () => {
 
@@ -174,27 +175,12 @@ describe('Badges', () => {
 
           const checkPayments = async ({ husd, hypha, hvoice } : { husd: number, hypha: number, hvoice: number}) => {
 
-            //Get payment documents (last 3)
-            let docs = environment.getDaoDocuments();
+            //All the tokens of a claim are in the last payment receipt
+            const payment = getLastPaymentAmounts(environment);
 
-            let payments: any = getDocumentsByType(docs, 'payment').slice(-3);
-
-            payments = payments.map(
-              (p: Document) => assetToNumber(
-                getContent(
-                  getContentGroupByLabel(p, 'details'),
-                  'amount'
-                ).value[1] as string
-              )
-            )
-
-            let hyphaPayment, hvoicePayment, husdPayment;
-
-            [hyphaPayment, hvoicePayment, husdPayment] = payments;
-
-            expect(parseFloat(hyphaPayment)).toBeCloseTo(hypha, 1);
-            expect(parseFloat(hvoicePayment)).toBeCloseTo(hvoice, 1);
-            expect(parseFloat(husdPayment)).toBeCloseTo(husd, 1);
+            expect(payment.reward).toBeCloseTo(hypha, 1);
+            expect(payment.voice).toBeCloseTo(hvoice, 1);
+            expect(payment.peg).toBeCloseTo(husd, 1);
           };
 
           //
@@ -223,4 +209,69 @@ describe('Badges', () => {
           }
         }
     }, 600000);
+
+    it('Keep edge badges of DAOs without a member badges index', async () => {
+
+        //Bits of the system badge types in the member badges masks
+        const ADMIN_BIT = 1 << 2;
+        const ENROLLER_BIT = 1 << 3;
+
+        const environment = await setupEnvironment();
+
+        const dao = environment.getDao('test');
+
+        const onboarder = dao.settings.onboarderAccount;
+
+        const onboarderID = String(
+          environment.getDaoTableRows('members').find(member => member.name === onboarder).id
+        );
+
+        const getMask = () => environment.getDaoTableRows('memberbadges')
+                                         .find(row => String(row.member_id) === onboarderID)?.mask;
+
+        expect(getMask()).toBe(ADMIN_BIT | ENROLLER_BIT);
+
+        await environment.daoContract.contract.remenroller({
+            dao_id: dao.getId(),
+            enroller_account: onboarder
+        }, getAccountPermission(onboarder));
+
+        expect(getMask()).toBe(ADMIN_BIT);
+
+        //Drop the index so the DAO looks like one created before it existed,
+        //the admin badge is then only stored as an edge
+        environment.daoContract.resetTables('badgedaos');
+        environment.daoContract.resetTables('memberbadges');
+
+        expect(getMask()).toBeUndefined();
+
+        //Admins can still enroll members
+        await environment.createMember('test', 'unindexedmem');
+
+        //Setting a badge keeps the badges stored as edges
+        await environment.daoContract.contract.addenroller({
+            dao_id: dao.getId(),
+            enroller_account: onboarder
+        }, getAccountPermission(onboarder));
+
+        expect(getMask()).toBe(ADMIN_BIT | ENROLLER_BIT);
+
+        await environment.daoContract.contract.remenroller({
+            dao_id: dao.getId(),
+            enroller_account: onboarder
+        }, getAccountPermission(onboarder));
+
+        expect(getMask()).toBe(ADMIN_BIT);
+
+        await environment.daoContract.contract.indexbadges({
+            dao_id: dao.getId(),
+            from: ''
+        }, getAccountPermission(environment.daoContract));
+
+        expect(
+          environment.getDaoTableRows('badgedaos').map(row => String(row.dao_id))
+        ).toContain(dao.getId());
+
+        expect(getMask()).toBe(ADMIN_BIT);
+    });
 });
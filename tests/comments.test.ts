@@ -300,4 +300,146 @@ describe('Proposal', () => {
         expect(getDocumentsByType(environment.getDaoDocuments(), 'comment').length).toBe(0);
     });
 
+    it('Reactions are counted by type', async() => {
+        const environment = await setupEnvironment();
+        const dao = environment.getDao('test');
+
+        await environment.daoContract.contract.propose({
+            dao_id: dao.getId(),
+            proposer: dao.members[0].account.accountName,
+            proposal_type: 'role',
+            publish: false,
+            content_groups: getSampleRole().content_groups
+        });
+
+        const proposal = last(getDocumentsByType(environment.getDaoDocuments(), 'role'));
+        const commentSection = last(getDocumentsByType(environment.getDaoDocuments(), 'cmnt.section'));
+
+        await environment.daoContract.contract.cmntadd({
+            author: dao.members[0].account.accountName,
+            content: 'Count me',
+            comment_or_section_id: commentSection.id
+        }, getAccountPermission(dao.members[0].account));
+
+        const comment = last(getDocumentsByType(environment.getDaoDocuments(), 'comment'));
+
+        const getCount = (type: string) => environment.getDaoTableRows('reactcounts')
+                                                      .filter(row => row.type === type)
+                                                      .reduce((count, row) => count + Number(row.count), 0);
+
+        const getReactions = () => environment.getDaoTableRows('reactions')
+                                              .filter(row => String(row.likeable_id) === comment.id);
+
+        const react = (member: number) => environment.daoContract.contract.reactadd({
+            user: dao.members[member].account.accountName,
+            reaction: 'liked',
+            document_id: comment.id
+        }, getAccountPermission(dao.members[member].account));
+
+        const unreact = (member: number) => environment.daoContract.contract.reactrem({
+            user: dao.members[member].account.accountName,
+            document_id: comment.id
+        }, getAccountPermission(dao.members[member].account));
+
+        await react(0);
+        expect(getCount('liked')).toBe(1);
+
+        await react(1);
+        expect(getCount('liked')).toBe(2);
+        expect(getReactions()).toHaveLength(2);
+
+        await unreact(0);
+        expect(getCount('liked')).toBe(1);
+        expect(getReactions()).toHaveLength(1);
+
+        await react(0);
+        expect(getCount('liked')).toBe(2);
+
+        //Reacting twice doesn't change the count
+        await expect(react(0)).rejects.toThrow(/already reacted/);
+        expect(getCount('liked')).toBe(2);
+
+        //Rows of removed documents are erased
+        await environment.daoContract.contract.proposerem({
+            proposer: dao.members[0].account.accountName,
+            proposal_id: proposal.id
+        });
+
+        expect(getReactions()).toHaveLength(0);
+        expect(environment.getDaoTableRows('reactcounts')).toHaveLength(0);
+    });
+
+    it('Comment sections with many comments are removed in several steps', async() => {
+        const environment = await setupEnvironment();
+        const dao = environment.getDao('test');
+
+        //More comments than the ones removed on each step
+        const commentCount = 60;
+
+        await environment.daoContract.contract.propose({
+            dao_id: dao.getId(),
+            proposer: dao.members[0].account.accountName,
+            proposal_type: 'role',
+            publish: false,
+            content_groups: getSampleRole().content_groups
+        });
+
+        const proposal = last(getDocumentsByType(environment.getDaoDocuments(), 'role'));
+        const commentSection = last(getDocumentsByType(environment.getDaoDocuments(), 'cmnt.section'));
+
+        for (let i = 0; i < commentCount; ++i) {
+            await environment.daoContract.contract.cmntadd({
+                author: dao.members[0].account.accountName,
+                content: `Comment ${i}`,
+                comment_or_section_id: commentSection.id
+            }, getAccountPermission(dao.members[0].account));
+        }
+
+        const comment = last(getDocumentsByType(environment.getDaoDocuments(), 'comment'));
+
+        await environment.daoContract.contract.reactadd({
+            user: dao.members[1].account.accountName,
+            reaction: 'liked',
+            document_id: comment.id
+        }, getAccountPermission(dao.members[1].account));
+
+        await environment.daoContract.contract.proposerem({
+            proposer: dao.members[0].account.accountName,
+            proposal_id: proposal.id
+        });
+
+        //Only part of the comments are removed by the first step
+        let comments = getDocumentsByType(environment.getDaoDocuments(), 'comment');
+
+        expect(comments.length).toBeGreaterThan(0);
+        expect(comments.length).toBeLessThan(commentCount);
+        expect(getDocumentsByType(environment.getDaoDocuments(), 'cmnt.section')).toHaveLength(1);
+        expect(environment.getDaoTableRows('secremovals')).toHaveLength(1);
+
+        //Comments can't be added while the section is being removed
+        await expect(environment.daoContract.contract.cmntadd({
+            author: dao.members[1].account.accountName,
+            content: 'Too late',
+            comment_or_section_id: comments[0].id
+        }, getAccountPermission(dao.members[1].account))).rejects.toThrow(/being removed/);
+
+        await expect(environment.daoContract.contract.cmntadd({
+            author: dao.members[1].account.accountName,
+            content: 'Too late',
+            comment_or_section_id: commentSection.id
+        }, getAccountPermission(dao.members[1].account))).rejects.toThrow(/being removed/);
+
+        //The rest are removed by the scheduled steps
+        for (let i = 0; i < commentCount && environment.getDaoTableRows('secremovals').length > 0; ++i) {
+            await environment.daoContract.contract.executenext({});
+        }
+
+        expect(environment.getDaoTableRows('secremovals')).toHaveLength(0);
+        expect(getDocumentsByType(environment.getDaoDocuments(), 'comment')).toHaveLength(0);
+        expect(getDocumentsByType(environment.getDaoDocuments(), 'cmnt.section')).toHaveLength(0);
+        expect(getEdgesByFilter(environment.getDaoEdges(), { from_node: proposal.id, edge_name: 'cmntsect' })).toHaveLength(0);
+        expect(environment.getDaoTableRows('reactions')).toHaveLength(0);
+        expect(environment.getDaoTableRows('reactcounts')).toHaveLength(0);
+    }, 600000);
+
 });
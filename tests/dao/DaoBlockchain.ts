@@ -460,6 +460,12 @@ export class DaoBlockchain extends Blockchain {
         return this.daoContract.getTableRowsScoped('edges')['dao'];
     }
 
+    // Rows of a dao contract table across all of its scopes
+    public getDaoTableRows(table: string): Array<any> {
+        const scopes = this.daoContract.getTableRowsScoped(table) ?? {};
+        return Object.keys(scopes).reduce((rows, scope) => rows.concat(scopes[scope]), []);
+    }
+
     public getIssuedHvoice(dao: Dao): Asset {
         return Asset.fromString(
             this.peerContracts.voice.getTableRowsScoped('stat.v2')[dao.settings.tokens.voice.asset.symbol][0].supply
@@ -0,0 +1,221 @@
+//Host side differential test of the fixed point token arithmetic against
+//the floating point formulas it replaced
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+#include <fixed_point.hpp>
+#include <salary.hpp>
+
+using namespace hypha;
+
+namespace
+{
+    int failures = 0;
+
+    void expect(bool condition, const char* what)
+    {
+        if (!condition) {
+            ++failures;
+            if (failures < 20) {
+                std::printf("FAILED: %s\n", what);
+            }
+        }
+    }
+
+    template <class F>
+    bool throws(F&& f)
+    {
+        try {
+            f();
+        }
+        catch (const std::runtime_error&) {
+            return true;
+        }
+
+        return false;
+    }
+
+    //Previous token helpers
+    double normalizeToken(const eosio::asset& token)
+    {
+        return static_cast<double>(token.amount) / std::pow(10, token.symbol.precision());
+    }
+
+    eosio::asset denormalizeToken(double amountNormalized, const eosio::asset& token)
+    {
+        return eosio::asset{ static_cast<int64_t>(amountNormalized * std::pow(10, token.symbol.precision())), token.symbol };
+    }
+
+    //Previous salary calculation, percentages and multipliers as fractions
+    struct FloatSalaryConfig
+    {
+        double periodSalary;
+        double deferredPerc;
+        double voiceMultipler;
+        double rewardMultipler;
+        double pegMultipler;
+    };
+
+    AssetBatch floatSalaries(const FloatSalaryConfig& salaryConf, const AssetBatch& tokens)
+    {
+        AssetBatch salaries;
+
+        double pegSalaryPerPeriod = salaryConf.periodSalary * (1.0 - salaryConf.deferredPerc);
+        salaries.peg = denormalizeToken(pegSalaryPerPeriod * salaryConf.pegMultipler, tokens.peg);
+
+        double rewardSalaryPerPeriod = (salaryConf.periodSalary * salaryConf.deferredPerc);
+        salaries.reward = denormalizeToken(rewardSalaryPerPeriod * salaryConf.rewardMultipler, tokens.reward);
+
+        double voiceSalaryPerPeriod = salaryConf.periodSalary * salaryConf.voiceMultipler;
+        salaries.voice = denormalizeToken(voiceSalaryPerPeriod, tokens.voice);
+
+        return salaries;
+    }
+
+    //The float results are truncated after rounding errors, so they can be one 
+    //unit off the exact result, plus the precision lost by doubles past 2^53
+    bool closeTo(const eosio::asset& exact, const eosio::asset& approx)
+    {
+        auto tolerance = 1 + std::llabs(exact.amount) / (int64_t(1) << 50);
+
+        return exact.symbol == approx.symbol && std::llabs(exact.amount - approx.amount) <= tolerance;
+    }
+
+    void testMulDiv()
+    {
+        expect(fixed::mulDiv(7, 3, 2) == 10, "mulDiv truncates");
+        expect(fixed::mulDiv(-7, 3, 2) == -10, "mulDiv truncates towards zero");
+        expect(fixed::mulDiv(0, 5, 3) == 0, "mulDiv of zero");
+
+        //Intermediate products beyond 64 bits
+        expect(fixed::mulDiv(4'000'000'000'000'000'000, 3, 4) == 3'000'000'000'000'000'000, "mulDiv with 128 bit intermediate");
+        expect(fixed::mulDiv(INT64_MAX, INT64_MAX, INT64_MAX) == INT64_MAX, "mulDiv of the largest values");
+
+        expect(throws([] { fixed::mulDiv(1, 1, 0); }), "mulDiv fails on division by zero");
+        expect(throws([] { fixed::mulDiv(INT64_MAX, 2, 1); }), "mulDiv fails when the result doesn't fit");
+
+        for (int64_t value = 1; value < 100'000'000; value = value * 3 + 7) {
+            for (int64_t num = 1; num <= 1000; num += 37) {
+                for (int64_t den = 1; den <= 1000; den += 53) {
+                    int64_t exact = fixed::mulDiv(value, num, den);
+                    int64_t approx = static_cast<int64_t>(static_cast<double>(value) * num / den);
+                    expect(std::llabs(exact - approx) <= 1, "mulDiv matches the float formula");
+                }
+            }
+        }
+    }
+
+    void testConvert()
+    {
+        const eosio::symbol USD("USD", 2);
+        const eosio::symbol HYPHA("HYPHA", 2);
+        const eosio::symbol HUSD("HUSD", 2);
+        const eosio::symbol SEEDS("SEEDS", 4);
+        const eosio::symbol TLOS("TLOS", 4);
+        const eosio::symbol BTC("BTC", 8);
+
+        expect(fixed::convert(eosio::asset{ 125, USD }, SEEDS, 4, 5).amount == 10000, "convert to a higher precision");
+        expect(fixed::convert(eosio::asset{ 12345678, BTC }, USD).amount == 12, "convert to a lower precision truncates");
+        expect(fixed::units(3, USD).amount == 300, "units of a symbol");
+        expect(fixed::pow10(18) == 1'000'000'000'000'000'000, "largest power of ten");
+        expect(throws([] { fixed::pow10(19); }), "pow10 fails past the int64 range");
+
+        const eosio::symbol symbols[] = { USD, HYPHA, HUSD, SEEDS, TLOS, BTC };
+
+        for (auto& from : symbols) {
+            for (auto& to : symbols) {
+                for (int64_t amount = 1; amount < 10'000'000'000; amount = amount * 7 + 3) {
+                    for (int64_t num = 1; num <= 500; num += 41) {
+                        for (int64_t den = 1; den <= 500; den += 67) {
+                            eosio::asset quantity{ amount, from };
+
+                            auto exact = fixed::convert(quantity, to, num, den);
+                            auto approx = denormalizeToken(normalizeToken(quantity) * num / den, eosio::asset{ 0, to });
+
+                            expect(closeTo(exact, approx), "convert matches the float formula");
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void testSalaries()
+    {
+        const eosio::symbol USD("USD", 2);
+
+        const AssetBatch tokenSets[] = {
+            { eosio::asset{ 0, eosio::symbol("HYPHA", 2) }, eosio::asset{ 0, eosio::symbol("HUSD", 2) }, eosio::asset{ 0, eosio::symbol("HVOICE", 2) } },
+            { eosio::asset{ 0, eosio::symbol("BRAIN", 4) }, eosio::asset{ 0, eosio::symbol("TLOS", 4) }, eosio::asset{ 0, eosio::symbol("VOICE", 2) } },
+            { eosio::asset{ 0, eosio::symbol("REWARD", 8) }, eosio::asset{ 0, eosio::symbol("PEG", 6) }, eosio::asset{ 0, eosio::symbol("VOICE", 4) } }
+        };
+
+        const int64_t multipliers[] = { 0, 50, 100, 150, 200, 333 };
+
+        int64_t cases = 0;
+
+        for (auto& tokens : tokenSets) {
+            for (int64_t usd = 1; usd < 5'000'000; usd += 997) {
+                for (int64_t timeShare = 10; timeShare <= 100; timeShare += 15) {
+                    for (int64_t deferred = 0; deferred <= 100; deferred += 25) {
+                        for (auto multiplier : multipliers) {
+                            eosio::asset periodSalary{ usd, USD };
+
+                            auto exact = calculateSalaries(SalaryConfig {
+                                .periodSalary = periodSalary,
+                                .timeShare = timeShare,
+                                .deferredPerc = deferred,
+                                .voiceMultipler = multiplier,
+                                .rewardMultipler = multiplier,
+                                .pegMultipler = multiplier
+                            }, tokens);
+
+                            auto approx = floatSalaries(FloatSalaryConfig {
+                                .periodSalary = normalizeToken(periodSalary) * (timeShare / 100.0),
+                                .deferredPerc = deferred / 100.0,
+                                .voiceMultipler = multiplier / 100.0,
+                                .rewardMultipler = multiplier / 100.0,
+                                .pegMultipler = multiplier / 100.0
+                            }, tokens);
+
+                            expect(closeTo(exact.peg, approx.peg), "peg salary matches the float formula");
+                            expect(closeTo(exact.reward, approx.reward), "reward salary matches the float formula");
+                            expect(closeTo(exact.voice, approx.voice), "voice salary matches the float formula");
+
+                            ++cases;
+                        }
+                    }
+                }
+            }
+        }
+
+        std::printf("salary cases: %lld\n", static_cast<long long>(cases));
+
+        AssetBatch noVoice = tokenSets[0];
+        noVoice.voice = eosio::asset{};
+
+        expect(
+            throws([&] { calculateSalaries(SalaryConfig { .periodSalary = eosio::asset{ 100, USD }, .deferredPerc = 50 }, noVoice); }),
+            "salaries fail without a voice token"
+        );
+    }
+}
+
+int main()
+{
+    testMulDiv();
+    testConvert();
+    testSalaries();
+
+    if (failures) {
+        std::printf("%d checks failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    std::printf("all checks passed\n");
+
+    return EXIT_SUCCESS;
+}
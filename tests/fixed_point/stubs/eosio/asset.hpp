@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+
+#include <eosio/symbol.hpp>
+
+//Minimal host replacement of the eosio asset, only what the fixed point code uses
+
+namespace eosio
+{
+    struct asset
+    {
+        static constexpr int64_t max_amount = (1LL << 62) - 1;
+
+        int64_t amount = 0;
+        eosio::symbol symbol;
+
+        asset() = default;
+
+        asset(int64_t a, eosio::symbol s) : amount(a), symbol(s)
+        {
+            if (!is_valid()) {
+                throw std::runtime_error("invalid asset");
+            }
+        }
+
+        bool is_amount_within_range() const { return -max_amount <= amount && amount <= max_amount; }
+        bool is_valid() const { return is_amount_within_range() && symbol.is_valid(); }
+
+        asset& operator+=(const asset& other)
+        {
+            if (symbol != other.symbol) {
+                throw std::runtime_error("attempt to add asset with different symbol");
+            }
+
+            amount += other.amount;
+
+            return *this;
+        }
+    };
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+//Minimal host replacement of the eosio symbol, only what the fixed point code uses
+
+using int128_t = __int128;
+using uint128_t = unsigned __int128;
+
+namespace eosio
+{
+    class symbol
+    {
+    public:
+        constexpr symbol() = default;
+
+        constexpr symbol(std::string_view code, uint8_t precision)
+        {
+            for (auto it = code.rbegin(); it != code.rend(); ++it) {
+                m_value = (m_value << 8) | static_cast<uint8_t>(*it);
+            }
+
+            m_value = (m_value << 8) | precision;
+        }
+
+        constexpr uint8_t precision() const { return static_cast<uint8_t>(m_value & 0xFF); }
+        constexpr uint64_t raw() const { return m_value; }
+        constexpr bool is_valid() const { return m_value != 0 && precision() <= 18; }
+
+        friend constexpr bool operator==(const symbol& a, const symbol& b) { return a.m_value == b.m_value; }
+        friend constexpr bool operator!=(const symbol& a, const symbol& b) { return a.m_value != b.m_value; }
+
+    private:
+        uint64_t m_value = 0;
+    };
+}
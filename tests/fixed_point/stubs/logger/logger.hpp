@@ -0,0 +1,13 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+
+//Failed checks throw on the host so the tests can expect them
+
+#define EOS_CHECK(condition, message)                    \
+    {                                                    \
+        if (!(condition)) {                              \
+            throw std::runtime_error(std::string(message)); \
+        }                                                \
+    }
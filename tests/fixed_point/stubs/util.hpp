@@ -0,0 +1,14 @@
+#pragma once
+
+#include <sstream>
+#include <string>
+
+//Host replacement of the contract utilities used by the fixed point code
+
+template <class... Args>
+std::string to_str(Args&&... args)
+{
+    std::stringstream ss;
+    (ss << ... << args);
+    return ss.str();
+}
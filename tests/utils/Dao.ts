@@ -2,6 +2,8 @@ import { DaoBlockchain } from "../dao/DaoBlockchain";
 import { Content, ContentGroup, ContentType, CONTENT_GROUP_LABEL, DETAILS_CONTENT_GROUP_LABEL, Document, SYSTEM_CONTENT_GROUP_LABEL } from "../types/Document"
 import { Edge } from "../types/Edge";
 import { Period } from "../types/Periods";
+import { Asset } from "../types/Asset";
+import { last } from "./Arrays";
 
 const TYPE_LABEL = 'type';
 
@@ -89,3 +91,22 @@ export const getNextPeriod = (environment: DaoBlockchain, currentPeriod: Documen
 
   return new Period(nextPeriod);
 }
+
+// A payment receipt holds one item per paid token
+export const getLastPaymentAmounts = (environment: DaoBlockchain) => {
+
+  const receipt = last(getDocumentsByType(environment.getDaoDocuments(), 'payment'));
+
+  const details = getDetailsGroup(receipt);
+
+  const getAmount = (label: string): number => {
+    const amount = getContent(details, label);
+    return amount ? Asset.fromString(amount.value[1] as string).toFloat() : 0;
+  };
+
+  return {
+    reward: getAmount('reward_amount'),
+    peg: getAmount('peg_amount'),
+    voice: getAmount('voice_amount')
+  };
+}
@@ -2,7 +2,7 @@ import { DaoBlockchain } from './dao/DaoBlockchain';
 import { setupEnvironment } from './setup';
 import { Document } from './types/Document';
 import { last } from './utils/Arrays';
-import { getDocumentsByType } from './utils/Dao';
+import { getDocumentsByType, getEdgesByFilter } from './utils/Dao';
 import { DocumentBuilder } from './utils/DocumentBuilder';
 import { toISOString } from './utils/Date';
 import { getDaoExpect } from './utils/Expect';
@@ -255,4 +255,87 @@ describe('Voting', () => {
             proposal_id: proposal.id
         }, environment.daos[0].members[0].getPermissions());
     });
+
+    it('Re-votes only apply their difference to the tally', async () => {
+        const environment = await setupEnvironment();
+        const now = new Date();
+        environment.setCurrentTime(now);
+
+        const dao = environment.getDao('test');
+        const [whale, member] = dao.members;
+
+        await environment.daoContract.contract.propose({
+            dao_id: dao.getId(),
+            proposer: whale.account.accountName,
+            proposal_type: 'role',
+            publish: true,
+            content_groups: getSampleRole().content_groups
+        });
+
+        const proposal = last(getDocumentsByType(
+            environment.getDaoDocuments(),
+            'role'
+        ));
+
+        const vote = (voter: string, option: string) => environment.daoContract.contract.vote({
+            voter,
+            proposal_id: proposal.id,
+            vote: option,
+            notes: `votes ${option}`
+        });
+
+        const getBallot = () => environment.getDaoTableRows('ballots')
+            .find(row => String(row.proposal_id) === proposal.id);
+
+        const testBallot = (props: { pass: number, abstain: number, fail: number }) => {
+            const ballot = getBallot();
+            expect(ballot.pass).toBe(`${props.pass}.00 HVOICE`);
+            expect(ballot.abstain).toBe(`${props.abstain}.00 HVOICE`);
+            expect(ballot.fail).toBe(`${props.fail}.00 HVOICE`);
+        };
+
+        await vote(whale.account.accountName, 'pass');
+        await vote(member.account.accountName, 'pass');
+        testLastVoteTally(getLastTally(environment), { pass: 101, fail: 0, abstain: 0 });
+        testBallot({ pass: 101, fail: 0, abstain: 0 });
+
+        // Voting the same option again doesn't count twice
+        await vote(whale.account.accountName, 'pass');
+        testLastVoteTally(getLastTally(environment), { pass: 101, fail: 0, abstain: 0 });
+        testBallot({ pass: 101, fail: 0, abstain: 0 });
+
+        // Only the power of the changed vote moves between options
+        await vote(whale.account.accountName, 'abstain');
+        testLastVoteTally(getLastTally(environment), { pass: 1, fail: 0, abstain: 100 });
+        testBallot({ pass: 1, fail: 0, abstain: 100 });
+
+        await vote(member.account.accountName, 'fail');
+        testLastVoteTally(getLastTally(environment), { pass: 0, fail: 1, abstain: 100 });
+        testBallot({ pass: 0, fail: 1, abstain: 100 });
+
+        // The tally document is updated in place
+        expect(getEdgesByFilter(environment.getDaoEdges(), {
+            from_node: proposal.id,
+            edge_name: 'votetally'
+        })).toHaveLength(1);
+
+        // One current vote and one power snapshot per voter
+        expect(environment.getDaoTableRows('propvotes')
+            .filter(row => String(row.proposal_id) === proposal.id)).toHaveLength(2);
+        expect(environment.getDaoTableRows('voterpower')).toHaveLength(2);
+
+        const tomorrow = new Date();
+        tomorrow.setDate(tomorrow.getDate() + 1);
+        environment.setCurrentTime(tomorrow);
+
+        await environment.daoContract.contract.closedocprop({
+            proposal_id: proposal.id
+        }, whale.getPermissions());
+
+        // Rows only needed while voting are erased on close
+        expect(getBallot()).toBeUndefined();
+        expect(environment.getDaoTableRows('propvotes')
+            .filter(row => String(row.proposal_id) === proposal.id)).toHaveLength(0);
+        expect(environment.getDaoTableRows('voterpower')).toHaveLength(0);
+    });
 });